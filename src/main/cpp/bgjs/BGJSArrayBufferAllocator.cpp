@@ -0,0 +1,132 @@
+//
+// Created on 19.10.26.
+//
+
+#include "BGJSArrayBufferAllocator.h"
+
+#include <string.h>
+
+BGJSArrayBufferAllocator::BGJSArrayBufferAllocator(size_t maxCachedBytes) :
+		_backingAllocator(v8::ArrayBuffer::Allocator::NewDefaultAllocator()),
+		_maxCachedBytes((int64_t)maxCachedBytes) {
+	_liveBytes = 0;
+	_cachedBytes = 0;
+	for (auto &sizeClass : _sizeClasses) {
+		sizeClass.head = nullptr;
+	}
+}
+
+BGJSArrayBufferAllocator::~BGJSArrayBufferAllocator() {
+	trim();
+}
+
+int BGJSArrayBufferAllocator::getSizeClass(size_t length) {
+	if (length > kMaxBlockSize) return -1;
+
+	int sizeClass = 0;
+	size_t blockSize = kMinBlockSize;
+	while (blockSize < length) {
+		blockSize <<= 1;
+		sizeClass++;
+	}
+	return sizeClass;
+}
+
+size_t BGJSArrayBufferAllocator::getBlockSize(int sizeClass) {
+	return kMinBlockSize << sizeClass;
+}
+
+void* BGJSArrayBufferAllocator::allocateBlock(size_t length, bool zeroed) {
+	const int sizeClass = getSizeClass(length);
+	void *data = nullptr;
+
+	if (sizeClass >= 0) {
+		SizeClass &entry = _sizeClasses[sizeClass];
+		{
+			std::lock_guard<std::mutex> lock(entry.mutex);
+			FreeBlock *block = entry.head;
+			if (block) {
+				entry.head = block->next;
+				data = block;
+			}
+		}
+		if (data) {
+			_cachedBytes.fetch_sub(getBlockSize(sizeClass), std::memory_order_relaxed);
+			// only the requested range is visible to js, so there is no need to clear the whole block
+			if (zeroed) {
+				memset(data, 0, length);
+			}
+		} else {
+			const size_t blockSize = getBlockSize(sizeClass);
+			data = zeroed ? _backingAllocator->Allocate(blockSize) : _backingAllocator->AllocateUninitialized(blockSize);
+		}
+	} else {
+		data = zeroed ? _backingAllocator->Allocate(length) : _backingAllocator->AllocateUninitialized(length);
+	}
+
+	if (data) {
+		_liveBytes.fetch_add(length, std::memory_order_relaxed);
+	}
+	return data;
+}
+
+void* BGJSArrayBufferAllocator::Allocate(size_t length) {
+	return allocateBlock(length, true);
+}
+
+void* BGJSArrayBufferAllocator::AllocateUninitialized(size_t length) {
+	return allocateBlock(length, false);
+}
+
+void BGJSArrayBufferAllocator::Free(void* data, size_t length) {
+	if (!data) return;
+	_liveBytes.fetch_sub(length, std::memory_order_relaxed);
+
+	const int sizeClass = getSizeClass(length);
+	if (sizeClass < 0) {
+		_backingAllocator->Free(data, length);
+		return;
+	}
+
+	// keep the block if the cache has room for it
+	const size_t blockSize = getBlockSize(sizeClass);
+	if (_cachedBytes.fetch_add(blockSize, std::memory_order_relaxed) + (int64_t)blockSize > _maxCachedBytes) {
+		_cachedBytes.fetch_sub(blockSize, std::memory_order_relaxed);
+		_backingAllocator->Free(data, blockSize);
+		return;
+	}
+
+	SizeClass &entry = _sizeClasses[sizeClass];
+	FreeBlock *block = (FreeBlock*)data;
+	std::lock_guard<std::mutex> lock(entry.mutex);
+	block->next = entry.head;
+	entry.head = block;
+}
+
+int64_t BGJSArrayBufferAllocator::getLiveBytes() const {
+	return _liveBytes.load(std::memory_order_relaxed);
+}
+
+int64_t BGJSArrayBufferAllocator::getCachedBytes() const {
+	return _cachedBytes.load(std::memory_order_relaxed);
+}
+
+void BGJSArrayBufferAllocator::trim() {
+	for (int sizeClass = 0; sizeClass < kNumSizeClasses; sizeClass++) {
+		SizeClass &entry = _sizeClasses[sizeClass];
+		FreeBlock *block;
+		{
+			std::lock_guard<std::mutex> lock(entry.mutex);
+			block = entry.head;
+			entry.head = nullptr;
+		}
+
+		const size_t blockSize = getBlockSize(sizeClass);
+		while (block) {
+			FreeBlock *next = block->next;
+			_backingAllocator->Free(block, blockSize);
+			_cachedBytes.fetch_sub(blockSize, std::memory_order_relaxed);
+			block = next;
+		}
+	}
+}
@@ -0,0 +1,75 @@
+//
+// Created on 19.10.26.
+//
+
+#ifndef __BGJSARRAYBUFFERALLOCATOR_H
+#define __BGJSARRAYBUFFERALLOCATOR_H	1
+
+#include <v8.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+/**
+ * BGJSArrayBufferAllocator
+ * ArrayBuffer allocator that keeps freed backing stores in per-size-class free lists and reuses them for later
+ * allocations of the same class. Sizes are rounded up to the next power of two between kMinBlockSize and kMaxBlockSize;
+ * larger buffers are not cached.
+ * Blocks are obtained from the default allocator, so that they are located inside of the v8 sandbox.
+ * Can be used from any thread.
+ */
+class BGJSArrayBufferAllocator : public v8::ArrayBuffer::Allocator {
+public:
+	static const size_t kMinBlockSize = 256;
+	static const size_t kMaxBlockSize = 64 * 1024;
+
+	/**
+	 * @param maxCachedBytes upper limit for the memory kept in free lists
+	 */
+	explicit BGJSArrayBufferAllocator(size_t maxCachedBytes);
+	~BGJSArrayBufferAllocator() override;
+
+	void* Allocate(size_t length) override;
+	void* AllocateUninitialized(size_t length) override;
+	void Free(void* data, size_t length) override;
+
+	/**
+	 * returns the number of bytes held by array buffers that were allocated and not yet freed
+	 */
+	int64_t getLiveBytes() const;
+
+	/**
+	 * returns the number of bytes kept in free lists
+	 */
+	int64_t getCachedBytes() const;
+
+	/**
+	 * returns all cached blocks to the system
+	 */
+	void trim();
+
+private:
+	static const int kNumSizeClasses = 9; // 256 B .. 64 KB
+
+	struct FreeBlock {
+		FreeBlock *next;
+	};
+
+	struct SizeClass {
+		std::mutex mutex;
+		FreeBlock *head;
+	};
+
+	static int getSizeClass(size_t length);
+	static size_t getBlockSize(int sizeClass);
+
+	void* allocateBlock(size_t length, bool zeroed);
+
+	std::unique_ptr<v8::ArrayBuffer::Allocator> _backingAllocator;
+	SizeClass _sizeClasses[kNumSizeClasses];
+	const int64_t _maxCachedBytes;
+	std::atomic<int64_t> _liveBytes;
+	std::atomic<int64_t> _cachedBytes;
+};
+
+#endif
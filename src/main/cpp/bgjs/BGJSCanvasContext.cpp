@@ -149,6 +149,7 @@ void BGJSCanvasContext::resize (int widthp, int heightp) {
 		createStencilBufferOnce();
 	}
 #endif
+	updateBufferMemory();
 
     glClear(GL_COLOR_BUFFER_BIT);
     checkGlError("glClear(resize)");
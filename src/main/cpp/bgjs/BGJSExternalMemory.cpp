@@ -0,0 +1,49 @@
+//
+// Created on 19.10.26.
+//
+
+#include "BGJSExternalMemory.h"
+#include "BGJSV8Engine.h"
+
+BGJSExternalMemory::BGJSExternalMemory(BGJSExternalMemoryType type) :
+		_engine(nullptr), _type(type), _size(0) {
+}
+
+BGJSExternalMemory::BGJSExternalMemory(BGJSV8Engine *engine, BGJSExternalMemoryType type, int64_t size) :
+		_engine(nullptr), _type(type), _size(0) {
+	setEngine(engine);
+	setSize(size);
+}
+
+BGJSExternalMemory::~BGJSExternalMemory() {
+	reset();
+}
+
+void BGJSExternalMemory::setEngine(BGJSV8Engine *engine) {
+	if (_engine == engine) {
+		return;
+	}
+	if (_engine) {
+		_engine->adjustExternalMemory(_type, -_size);
+	}
+	_engine = engine;
+	if (_engine) {
+		_engine->adjustExternalMemory(_type, _size);
+	}
+}
+
+void BGJSExternalMemory::setSize(int64_t size) {
+	const int64_t change = size - _size;
+	_size = size;
+	if (_engine && change) {
+		_engine->adjustExternalMemory(_type, change);
+	}
+}
+
+void BGJSExternalMemory::reset() {
+	setSize(0);
+}
+
+int64_t BGJSExternalMemory::getSize() const {
+	return _size;
+}
@@ -0,0 +1,62 @@
+//
+// Created on 19.10.26.
+//
+
+#ifndef __BGJSEXTERNALMEMORY_H
+#define __BGJSEXTERNALMEMORY_H	1
+
+#include <cstddef>
+#include <cstdint>
+
+class BGJSV8Engine;
+
+/**
+ * category of native memory retained by js objects
+ * all categories are reported to v8 as external memory; the totals are tracked per category
+ */
+enum class BGJSExternalMemoryType {
+	kHeap = 0,
+	kGPU = 1,
+	kCount = 2
+};
+
+/**
+ * BGJSExternalMemory
+ * Reports the size of a native allocation that is kept alive by a js object to the engine of that object.
+ * The reported size follows the lifetime of the instance: changing the size reports the difference, destroying the
+ * instance reports the release. Can be used from any thread.
+ */
+class BGJSExternalMemory {
+public:
+	explicit BGJSExternalMemory(BGJSExternalMemoryType type);
+	BGJSExternalMemory(BGJSV8Engine *engine, BGJSExternalMemoryType type, int64_t size = 0);
+	~BGJSExternalMemory();
+
+	BGJSExternalMemory(const BGJSExternalMemory&) = delete;
+	BGJSExternalMemory& operator=(const BGJSExternalMemory&) = delete;
+
+	/**
+	 * sets the engine the memory is reported to
+	 * memory that was already reported to another engine is moved
+	 */
+	void setEngine(BGJSV8Engine *engine);
+
+	/**
+	 * sets the current size of the allocation
+	 */
+	void setSize(int64_t size);
+
+	/**
+	 * reports the allocation as released
+	 */
+	void reset();
+
+	int64_t getSize() const;
+
+private:
+	BGJSV8Engine *_engine;
+	BGJSExternalMemoryType _type;
+	int64_t _size;
+};
+
+#endif
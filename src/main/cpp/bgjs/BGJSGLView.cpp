@@ -89,6 +89,8 @@ void BGJSGLView::onSetViewData(float density, bool doNoClearOnFlip, int width, i
 
     context2d = new BGJSCanvasContext(width, height);
     context2d->backingStoreRatio = density;
+    // buffers and textures of the context report their memory to the engine themselves
+    context2d->setEngine(getEngine());
 #ifdef DEBUG
     LOGI("pixel Ratio %f", density);
 #endif
@@ -0,0 +1,88 @@
+//
+// Created on 19.10.26.
+//
+
+#include "BGJSLockProfiler.h"
+
+// the last site collects all owners that did not fit into the table
+static BGJSLockSite _sites[BGJSLockProfiler::kMaxSites + 1];
+static const char* const kOtherOwnerName = "(other)";
+
+std::atomic<bool> BGJSLockProfiler::_enabled = {false};
+
+static void updateMax(std::atomic<uint64_t> &max, uint64_t value) {
+	uint64_t current = max.load(std::memory_order_relaxed);
+	while (value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+
+static int getBucket(uint64_t time) {
+	uint64_t micros = time / 1000;
+	if (!micros) {
+		return 0;
+	}
+	int bucket = 64 - __builtin_clzll(micros);
+	return bucket < BGJSLockSite::kNumBuckets ? bucket : BGJSLockSite::kNumBuckets - 1;
+}
+
+void BGJSLockProfiler::setEnabled(bool enabled) {
+	_sites[kMaxSites].ownerName.store(kOtherOwnerName, std::memory_order_relaxed);
+	_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+BGJSLockSite* BGJSLockProfiler::getSite(const char *ownerName) {
+	uint32_t index = (uint32_t)(((uintptr_t)ownerName >> 3) * 2654435761u) % kMaxSites;
+	for (int i = 0; i < kMaxSites; i++) {
+		BGJSLockSite &site = _sites[index];
+		const char *siteOwnerName = site.ownerName.load(std::memory_order_acquire);
+		if (siteOwnerName == ownerName) {
+			return &site;
+		}
+		if (!siteOwnerName) {
+			// claim the free site; if another thread was faster, it might have claimed it for the same owner
+			if (site.ownerName.compare_exchange_strong(siteOwnerName, ownerName, std::memory_order_acq_rel) ||
+				siteOwnerName == ownerName) {
+				return &site;
+			}
+		}
+		index = (index + 1) % kMaxSites;
+	}
+	return &_sites[kMaxSites];
+}
+
+BGJSLockSite* BGJSLockProfiler::getSites(int *numSites) {
+	*numSites = kMaxSites + 1;
+	return _sites;
+}
+
+void BGJSLockProfiler::recordAcquire(BGJSLockSite *site, bool recursive, uint64_t waitTime) {
+	site->numAcquires.fetch_add(1, std::memory_order_relaxed);
+	if (recursive) {
+		// a recursive lock never waits
+		site->numRecursiveAcquires.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	site->totalWaitTime.fetch_add(waitTime, std::memory_order_relaxed);
+	updateMax(site->maxWaitTime, waitTime);
+	site->waitHistogram[getBucket(waitTime)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void BGJSLockProfiler::recordRelease(BGJSLockSite *site, uint64_t holdTime) {
+	site->totalHoldTime.fetch_add(holdTime, std::memory_order_relaxed);
+	updateMax(site->maxHoldTime, holdTime);
+	site->holdHistogram[getBucket(holdTime)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void BGJSLockProfiler::reset() {
+	for (auto &site : _sites) {
+		site.numAcquires.store(0, std::memory_order_relaxed);
+		site.numRecursiveAcquires.store(0, std::memory_order_relaxed);
+		site.totalWaitTime.store(0, std::memory_order_relaxed);
+		site.maxWaitTime.store(0, std::memory_order_relaxed);
+		site.totalHoldTime.store(0, std::memory_order_relaxed);
+		site.maxHoldTime.store(0, std::memory_order_relaxed);
+		for (int i = 0; i < BGJSLockSite::kNumBuckets; i++) {
+			site.waitHistogram[i].store(0, std::memory_order_relaxed);
+			site.holdHistogram[i].store(0, std::memory_order_relaxed);
+		}
+	}
+}
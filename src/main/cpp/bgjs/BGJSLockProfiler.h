@@ -0,0 +1,110 @@
+//
+// Created on 19.10.26.
+//
+
+#ifndef __BGJSLOCKPROFILER_H
+#define __BGJSLOCKPROFILER_H	1
+
+#include <atomic>
+#include <stdint.h>
+#include <v8.h>
+#include <uv.h>
+
+/**
+ * statistics of all isolate locks taken with the same owner name
+ * bucket 0 of the histograms counts durations below 1µs, bucket i > 0 durations in [2^(i-1), 2^i) µs;
+ * the last bucket also counts everything above.
+ */
+struct BGJSLockSite {
+	static const int kNumBuckets = 24;
+
+	std::atomic<const char*> ownerName;
+	std::atomic<uint64_t> numAcquires;
+	std::atomic<uint64_t> numRecursiveAcquires;
+	std::atomic<uint64_t> totalWaitTime;
+	std::atomic<uint64_t> maxWaitTime;
+	std::atomic<uint64_t> totalHoldTime;
+	std::atomic<uint64_t> maxHoldTime;
+	std::atomic<uint32_t> waitHistogram[kNumBuckets];
+	std::atomic<uint32_t> holdHistogram[kNumBuckets];
+};
+
+/**
+ * BGJSLockProfiler
+ * Records how long threads wait for and hold the isolate lock, grouped by the owner name passed to V8Locker.
+ * Sites are kept in a fixed table keyed by the address of the owner name, so recording never allocates or compares
+ * strings; owner names must therefore be static strings (usually __FUNCTION__). If the table is full, further owners
+ * are recorded in a shared "(other)" site.
+ * Profiling is disabled by default and can be switched on and off at runtime; when it is disabled, a lock only pays
+ * for one relaxed atomic load. All times are in nanoseconds. Counters are updated independently, so a snapshot taken
+ * while locks are in use is not necessarily consistent.
+ */
+class BGJSLockProfiler {
+public:
+	static const int kMaxSites = 256;
+
+	static bool isEnabled() {
+		return _enabled.load(std::memory_order_relaxed);
+	}
+	static void setEnabled(bool enabled);
+
+	/**
+	 * returns the site for the specified owner name, creating it if required
+	 */
+	static BGJSLockSite* getSite(const char *ownerName);
+
+	/**
+	 * returns all sites; unused sites have no owner name
+	 */
+	static BGJSLockSite* getSites(int *numSites);
+
+	static void recordAcquire(BGJSLockSite *site, bool recursive, uint64_t waitTime);
+	static void recordRelease(BGJSLockSite *site, uint64_t holdTime);
+
+	/**
+	 * clears all counters; sites remain assigned to their owners
+	 */
+	static void reset();
+
+private:
+	static std::atomic<bool> _enabled;
+};
+
+/**
+ * Measures a single lock of an isolate for BGJSLockProfiler
+ * Has to be constructed right before and destroyed right after the v8::Locker it measures.
+ */
+class BGJSLockSample {
+protected:
+	BGJSLockSample(v8::Isolate *isolate, const char *ownerName) {
+		if (!BGJSLockProfiler::isEnabled()) {
+			_site = nullptr;
+			return;
+		}
+		_site = BGJSLockProfiler::getSite(ownerName);
+		_recursive = v8::Locker::IsLocked(isolate);
+		_time = uv_hrtime();
+	}
+
+	void acquired() {
+		if (_site) {
+			uint64_t now = uv_hrtime();
+			BGJSLockProfiler::recordAcquire(_site, _recursive, now - _time);
+			_time = now;
+		}
+	}
+
+	void released() {
+		// the hold time of a recursive lock is already part of the outer lock
+		if (_site && !_recursive) {
+			BGJSLockProfiler::recordRelease(_site, uv_hrtime() - _time);
+		}
+	}
+
+private:
+	BGJSLockSite *_site;
+	bool _recursive;
+	uint64_t _time;
+};
+
+#endif
@@ -0,0 +1,188 @@
+//
+// Created on 19.10.26.
+//
+
+#include "BGJSLogWriter.h"
+
+#include <atomic>
+#include <mutex>
+#include <stdio.h>
+#include <sys/time.h>
+#include <time.h>
+#include <uv.h>
+
+#include "os-android.h"
+
+#define LOG_TAG "BGJSLogWriter"
+
+// bounded multi-producer queue (see D. Vyukov, "Bounded MPMC queue"); the writer thread is the only consumer
+struct BGJSLogRecord {
+	std::atomic<size_t> sequence;
+	int level;
+	const char *tag;
+	std::string *message;
+};
+
+static const size_t kCapacity = 1024; // must be a power of two
+
+static BGJSLogRecord _records[kCapacity];
+static std::atomic<size_t> _enqueuePosition;
+static size_t _dequeuePosition;
+static std::atomic<uint32_t> _numDroppedRecords;
+
+static std::once_flag _startFlag;
+static uv_thread_t _thread;
+static uv_sem_t _semaphore;
+static std::atomic<bool> _writerWaiting;
+
+static std::mutex _fileMutex;
+static std::string _filePath;
+static std::atomic<bool> _fileChanged;
+
+void BGJSLogWriter::start() {
+	for (size_t i = 0; i < kCapacity; i++) {
+		_records[i].sequence.store(i, std::memory_order_relaxed);
+	}
+	_enqueuePosition = 0;
+	_dequeuePosition = 0;
+	_numDroppedRecords = 0;
+	_writerWaiting = false;
+	uv_sem_init(&_semaphore, 0);
+
+	// the writer runs for the lifetime of the process
+	uv_thread_create(&_thread, &BGJSLogWriter::run, nullptr);
+}
+
+void BGJSLogWriter::write(int level, const char *tag, std::string message) {
+	std::call_once(_startFlag, &BGJSLogWriter::start);
+
+	BGJSLogRecord *record;
+	size_t position = _enqueuePosition.load(std::memory_order_relaxed);
+	for (;;) {
+		record = &_records[position & (kCapacity - 1)];
+		const size_t sequence = record->sequence.load(std::memory_order_acquire);
+		const intptr_t diff = (intptr_t)sequence - (intptr_t)position;
+		if (diff == 0) {
+			if (_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+				break;
+			}
+		} else if (diff < 0) {
+			// queue is full; never block the logging thread
+			_numDroppedRecords.fetch_add(1, std::memory_order_relaxed);
+			return;
+		} else {
+			position = _enqueuePosition.load(std::memory_order_relaxed);
+		}
+	}
+
+	record->level = level;
+	record->tag = tag;
+	record->message = new std::string(std::move(message));
+	record->sequence.store(position + 1, std::memory_order_release);
+
+	// the writer only has to be woken up if it is waiting
+	if (_writerWaiting.exchange(false)) {
+		uv_sem_post(&_semaphore);
+	}
+}
+
+bool BGJSLogWriter::pop(int *level, const char **tag, std::string **message) {
+	BGJSLogRecord &record = _records[_dequeuePosition & (kCapacity - 1)];
+	if (record.sequence.load(std::memory_order_acquire) != _dequeuePosition + 1) {
+		return false;
+	}
+
+	*level = record.level;
+	*tag = record.tag;
+	*message = record.message;
+	record.sequence.store(_dequeuePosition + kCapacity, std::memory_order_release);
+	_dequeuePosition++;
+	return true;
+}
+
+bool BGJSLogWriter::isEmpty() {
+	const BGJSLogRecord &record = _records[_dequeuePosition & (kCapacity - 1)];
+	return record.sequence.load(std::memory_order_acquire) != _dequeuePosition + 1;
+}
+
+void BGJSLogWriter::setFile(const char *path) {
+	{
+		std::lock_guard<std::mutex> lock(_fileMutex);
+		_filePath = path ? path : "";
+	}
+	_fileChanged = true;
+
+	// make sure the writer exists and picks up the change
+	write(LOG_INFO, LOG_TAG, path ? std::string("Writing log to ") + path : "Stopped writing log to file");
+}
+
+static char getLevelChar(int level) {
+	switch (level) {
+		case ANDROID_LOG_VERBOSE: return 'V';
+		case ANDROID_LOG_DEBUG: return 'D';
+		case ANDROID_LOG_INFO: return 'I';
+		case ANDROID_LOG_WARN: return 'W';
+		case ANDROID_LOG_ERROR: return 'E';
+		case ANDROID_LOG_FATAL: return 'F';
+		default: return '?';
+	}
+}
+
+void BGJSLogWriter::run(void *arg) {
+	FILE *file = nullptr;
+
+	for (;;) {
+		if (_fileChanged.exchange(false)) {
+			if (file) {
+				fclose(file);
+				file = nullptr;
+			}
+			std::lock_guard<std::mutex> lock(_fileMutex);
+			if (!_filePath.empty()) {
+				file = fopen(_filePath.c_str(), "a");
+				if (!file) {
+					LOGE("Could not open log file %s", _filePath.c_str());
+				}
+			}
+		}
+
+		int level;
+		const char *tag;
+		std::string *message;
+		while (pop(&level, &tag, &message)) {
+			__android_log_write(level, tag, message->c_str());
+
+			if (file) {
+				struct timeval now;
+				gettimeofday(&now, nullptr);
+				struct tm local;
+				localtime_r(&now.tv_sec, &local);
+				char timestamp[32];
+				strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", &local);
+				fprintf(file, "%s.%03d %c/%s:%s\n", timestamp, (int)(now.tv_usec / 1000), getLevelChar(level), tag,
+						message->c_str());
+			}
+			delete message;
+		}
+
+		const uint32_t numDropped = _numDroppedRecords.exchange(0, std::memory_order_relaxed);
+		if (numDropped) {
+			LOGE("Dropped %u log messages", numDropped);
+			if (file) {
+				fprintf(file, "Dropped %u log messages\n", numDropped);
+			}
+		}
+
+		if (file) {
+			fflush(file);
+		}
+
+		// announce that the writer is about to wait, then check again to not miss a message queued in between
+		_writerWaiting = true;
+		if (!isEmpty() || _fileChanged) {
+			_writerWaiting = false;
+			continue;
+		}
+		uv_sem_wait(&_semaphore);
+	}
+}
@@ -0,0 +1,37 @@
+//
+// Created on 19.10.26.
+//
+
+#ifndef __BGJSLOGWRITER_H
+#define __BGJSLOGWRITER_H	1
+
+#include <string>
+
+/**
+ * BGJSLogWriter
+ * Writes log messages to logcat and, optionally, to a file on a background thread.
+ * Messages are passed through a bounded lock-free queue, so logging never blocks the calling thread; if the writer
+ * can not keep up, messages are dropped and the number of dropped messages is logged instead.
+ */
+class BGJSLogWriter {
+public:
+	/**
+	 * queues a message for writing
+	 * @param level android log priority
+	 * @param tag must remain valid for the lifetime of the process (usually a string literal)
+	 */
+	static void write(int level, const char *tag, std::string message);
+
+	/**
+	 * additionally appends all messages to the specified file; pass nullptr to stop writing to a file
+	 */
+	static void setFile(const char *path);
+
+private:
+	static void start();
+	static void run(void *arg);
+	static bool pop(int *level, const char **tag, std::string **message);
+	static bool isEmpty();
+};
+
+#endif
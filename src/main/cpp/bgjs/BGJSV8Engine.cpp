@@ -12,6 +12,9 @@
 #include "../v8/JNIV8Wrapper.h"
 #include "../v8/JNIV8GenericObject.h"
 #include "../v8/JNIV8Function.h"
+#include "../v8/JNIV8Serializer.h"
+#include "../v8/JNIV8Promise.h"
+#include "BGJSLogWriter.h"
 
 #include <android/asset_manager.h>
 #include <android/asset_manager_jni.h>
@@ -219,6 +222,7 @@ decltype(BGJSV8Engine::_jniV8Module) BGJSV8Engine::_jniV8Module = {nullptr};
 decltype(BGJSV8Engine::_jniV8Exception) BGJSV8Engine::_jniV8Exception = {nullptr};
 decltype(BGJSV8Engine::_jniV8JSException) BGJSV8Engine::_jniV8JSException = {nullptr};
 decltype(BGJSV8Engine::_jniStackTraceElement) BGJSV8Engine::_jniStackTraceElement = {nullptr};
+decltype(BGJSV8Engine::_jniV8LockProfile) BGJSV8Engine::_jniV8LockProfile = {nullptr};
 decltype(BGJSV8Engine::_jniV8Engine) BGJSV8Engine::_jniV8Engine = {nullptr};
 
 void BGJSV8Engine::RejectedPromiseHolderWeakPersistentCallback(const v8::WeakCallbackInfo<void> &data) {
@@ -377,12 +381,44 @@ bool BGJSV8Engine::forwardV8ExceptionToJNI(std::string messagePrefix, v8::Local<
 
     jobject exceptionAsObject = JNIV8Marshalling::v8value2jobject(exception);
 
-    // convert v8 stack trace to a java stack trace
-    jobject v8JSException;
-    jstring exceptionMessage = nullptr;
+    // message text and location are taken right away; the stack trace is materialized when it is first requested
+    // in java, because exceptions are often caught without ever being inspected
+    jint lineNumber = -1;
+    jstring fileName = nullptr;
+    if (!message.IsEmpty()) {
+        lineNumber = message->GetLineNumber(context).FromMaybe(-1);
+        // script resource might not be set if the exception came from native code
+        Local<Value> jsScriptResourceName = message->GetScriptResourceName();
+        if (jsScriptResourceName->IsString()) {
+            fileName = JNIV8Marshalling::v8string2jstring(jsScriptResourceName.As<String>());
+        }
+    }
+
+    jstring exceptionMessage = createExceptionMessage(messagePrefix, exception, fileName, lineNumber);
+
+    jobject v8JSException = env->NewObject(_jniV8JSException.clazz, _jniV8JSException.initId, getJObject(),
+                                           exceptionMessage, exceptionAsObject, causeException, fileName, lineNumber);
+
+    // throw final exception
+    jthrowable throwable = (jthrowable) env->NewObject(_jniV8Exception.clazz, _jniV8Exception.initId,
+                                                       JNIWrapper::string2jstring("An exception was thrown in JavaScript"),
+                                                       v8JSException);
+    if(throwOnMainThread) {
+        // this exception is going to crash the app; materialize it now while the engine is locked anyway
+        env->CallVoidMethod(v8JSException, _jniV8JSException.materializeId);
+        env->CallVoidMethod(getJObject(), _jniV8Engine.onThrowId, throwable);
+    } else {
+        env->Throw(throwable);
+    }
+
+    return true;
+}
+
+jstring BGJSV8Engine::createExceptionMessage(const std::string &messagePrefix, v8::Local<v8::Value> exception, jstring fileName, jint lineNumber) const {
+    Local<Context> context = getContext();
+    MaybeLocal<Value> maybeValue;
+    Local<Value> value;
 
-    jobjectArray stackTrace = nullptr;
-    bool error = false;
     if (exception->IsObject()) {
         // retrieve message (toString contains typename, we don't want that..)
         std::string strExceptionMessage;
@@ -406,23 +442,34 @@ bool BGJSV8Engine::forwardV8ExceptionToJNI(std::string messagePrefix, v8::Local<
         // and neither does the message
         // so we have to append that manually
         // for errors thrown from native code it might not be available though
-        if (strErrorName == "SyntaxError") {
-            int lineNumber = -1;
-            Maybe<int> maybeLineNumber = message->GetLineNumber(context);
-            if (!maybeLineNumber.IsNothing()) {
-                lineNumber = maybeLineNumber.ToChecked();
-            }
-            Local<Value> jsScriptResourceName = message->GetScriptResourceName();
-            if (jsScriptResourceName->IsString()) {
-                strExceptionMessage =
-                        JNIV8Marshalling::v8string2string(jsScriptResourceName.As<String>()) +
-                        (lineNumber > 0 ? ":" + std::to_string(lineNumber) : "") +
-                        " - " + strExceptionMessage;
-            }
+        if (strErrorName == "SyntaxError" && fileName) {
+            strExceptionMessage =
+                    JNIWrapper::jstring2string(fileName) +
+                    (lineNumber > 0 ? ":" + std::to_string(lineNumber) : "") +
+                    " - " + strExceptionMessage;
         }
 
-        exceptionMessage = JNIWrapper::string2jstring(messagePrefix + "[" + strErrorName + "] " + strExceptionMessage);
+        return JNIWrapper::string2jstring(messagePrefix + "[" + strErrorName + "] " + strExceptionMessage);
+    }
+
+    // if exception was not an Error object => use toString()
+    Local<String> stringRef;
+    if (!exception->ToString(context).ToLocal(&stringRef)) {
+        return JNIWrapper::string2jstring(messagePrefix);
+    }
+    return JNIWrapper::string2jstring(messagePrefix + JNIV8Marshalling::v8string2string(stringRef));
+}
+
+jobjectArray BGJSV8Engine::createJavaStackTrace(v8::Local<v8::Value> exception, jstring fileName, jint lineNumber) const {
+    JNIEnv *env = JNIWrapper::getEnvironment();
+    Local<Context> context = getContext();
+    MaybeLocal<Value> maybeValue;
+    Local<Value> value;
 
+    // convert v8 stack trace to a java stack trace
+    jobjectArray stackTrace = nullptr;
+    bool error = false;
+    if (exception->IsObject()) {
         Local<Function> getStackTraceFn = Local<Function>::New(_isolate, _getStackTraceFn);
 
         maybeValue = getStackTraceFn->Call(context, context->Global(), 1, &exception);
@@ -438,13 +485,13 @@ bool BGJSV8Engine::forwardV8ExceptionToJNI(std::string messagePrefix, v8::Local<
                 if (maybeValue.ToLocal(&value) && value->IsObject()) {
                     Local<Object> callSite = value.As<Object>();
 
-                    jstring fileName = nullptr;
+                    jstring frameFileName = nullptr;
                     jstring methodName = nullptr;
                     jstring functionName = nullptr;
                     jstring typeName = nullptr;
-                    jint lineNumber = 0;
+                    jint frameLineNumber = 0;
 
-                    CALLSITE_STRING(callSite, "getFileName", fileName);
+                    CALLSITE_STRING(callSite, "getFileName", frameFileName);
                     CALLSITE_STRING(callSite, "getMethodName", methodName);
                     CALLSITE_STRING(callSite, "getFunctionName", functionName);
                     CALLSITE_STRING(callSite, "getTypeName", typeName);
@@ -454,7 +501,7 @@ bool BGJSV8Engine::forwardV8ExceptionToJNI(std::string messagePrefix, v8::Local<
                     if (maybeValue.ToLocal(&value) && value->IsFunction()) {
                         maybeValue = value.As<Function>()->Call(context, callSite, 0, nullptr);
                         if (maybeValue.ToLocal(&value) && value->IsNumber()) {
-                            lineNumber = (jint) value.As<Number>()->IntegerValue(context).FromJust();
+                            frameLineNumber = (jint) value.As<Number>()->IntegerValue(context).FromJust();
                         }
                     }
 
@@ -462,10 +509,11 @@ bool BGJSV8Engine::forwardV8ExceptionToJNI(std::string messagePrefix, v8::Local<
                                                        typeName ? typeName : JNIWrapper::string2jstring("<unknown>"),
                                                        !methodName && !functionName ? JNIWrapper::string2jstring(
                                                                "<anonymous>") : methodName ? methodName : functionName,
-                                                       fileName, // fileName can be zero => maps to "Unknown Source" or "Native Method" (Depending on line numer)
-                                                       fileName ? (lineNumber >= 1 ? lineNumber : -1)
+                                                       frameFileName, // fileName can be zero => maps to "Unknown Source" or "Native Method" (Depending on line numer)
+                                                       frameFileName ? (frameLineNumber >= 1 ? frameLineNumber : -1)
                                                                 : -2); // -1 is unknown, -2 means native
                     env->SetObjectArrayElement(stackTrace, i, stackTraceElement);
+                    env->DeleteLocalRef(stackTraceElement);
                 } else {
                     error = true;
                     break;
@@ -476,21 +524,6 @@ bool BGJSV8Engine::forwardV8ExceptionToJNI(std::string messagePrefix, v8::Local<
 
     // if no stack trace was provided by v8, or if there was an error converting it, we still have to show something
     if (error || !stackTrace) {
-        int lineNumber = -1;
-        Maybe<int> maybeLineNumber = message->GetLineNumber(context);
-        if (!maybeLineNumber.IsNothing()) {
-            lineNumber = maybeLineNumber.ToChecked();
-        }
-
-        // script resource might not be set if the exception came from native code
-        jstring fileName;
-        Local<Value> jsScriptResourceName = message->GetScriptResourceName();
-        if (jsScriptResourceName->IsString()) {
-            fileName = JNIV8Marshalling::v8string2jstring(jsScriptResourceName.As<String>());
-        } else {
-            fileName = nullptr;
-        }
-
         // dummy trace entry
         stackTrace = env->NewObjectArray(1, _jniStackTraceElement.clazz,
                                          env->NewObject(_jniStackTraceElement.clazz, _jniStackTraceElement.initId,
@@ -500,27 +533,33 @@ bool BGJSV8Engine::forwardV8ExceptionToJNI(std::string messagePrefix, v8::Local<
                                                         fileName ? (lineNumber >= 1 ? lineNumber : -1) : -2));
     }
 
-    // if exception was not an Error object, or if .message is not set for some reason => use toString()
-    if (!exceptionMessage) {
-        exceptionMessage = JNIWrapper::string2jstring(messagePrefix + JNIV8Marshalling::v8string2string(exception->ToString(_isolate->GetCurrentContext()).ToLocalChecked()));
-    }
+    return stackTrace;
+}
 
-    // apply trace to js exception
-    v8JSException = env->NewObject(_jniV8JSException.clazz, _jniV8JSException.initId, exceptionMessage,
-                                   exceptionAsObject, causeException);
-    env->CallVoidMethod(v8JSException, _jniV8JSException.setStackTraceId, stackTrace);
+jboolean BGJSV8Engine::jniMaterializeStackTrace(JNIEnv *env, jobject obj, jobject exception, jobject v8Exception,
+                                                 jstring fileName, jint lineNumber, jboolean wait) {
+    auto engine = JNIWrapper::wrapObject<BGJSV8Engine>(obj);
+    // the stack trace can not be materialized anymore once the engine is stopped; the exception keeps its location
+    if (engine->_state != EState::kStarted) {
+        return (jboolean)true;
+    }
 
-    // throw final exception
-    jthrowable throwable = (jthrowable) env->NewObject(_jniV8Exception.clazz, _jniV8Exception.initId,
-                                                       JNIWrapper::string2jstring("An exception was thrown in JavaScript"),
-                                                       v8JSException);
-    if(throwOnMainThread) {
-        env->CallVoidMethod(getJObject(), _jniV8Engine.onThrowId, throwable);
-    } else {
-        env->Throw(throwable);
+    // exceptions are inspected on arbitrary threads, which might hold monitors that the js thread is waiting for
+    // => only lock the engine if requested, otherwise only proceed if this thread already holds the lock
+    if (!wait && !v8::Locker::IsLocked(engine->_isolate)) {
+        return (jboolean)false;
     }
 
-    return true;
+    V8Session session(engine.get(), __FUNCTION__);
+    v8::TryCatch try_catch(engine->_isolate);
+
+    Local<Value> exceptionRef = JNIV8Marshalling::jobject2v8value(v8Exception);
+
+    jobjectArray stackTrace = engine->createJavaStackTrace(exceptionRef, fileName, lineNumber);
+    env->CallVoidMethod(exception, _jniV8JSException.setStackTraceId, stackTrace);
+    env->DeleteLocalRef(stackTrace);
+
+    return (jboolean)true;
 }
 
 // Register
@@ -881,6 +920,14 @@ v8::Local<v8::Context> BGJSV8Engine::getContext() const {
     return scope.Escape(Local<Context>::New(_isolate, _context));
 }
 
+v8::Local<v8::Private> BGJSV8Engine::getWrapperCacheKey() const {
+    return Local<Private>::New(_isolate, _wrapperCacheKey);
+}
+
+uint32_t BGJSV8Engine::getNumClassTemplates() const {
+    return _numClassTemplates.load(std::memory_order_relaxed);
+}
+
 void BGJSV8Engine::js_process_nextTick(const v8::FunctionCallbackInfo<v8::Value> &args) {
     BGJSV8Engine *ctx = BGJSV8Engine::GetInstance(args.GetIsolate());
     if (args.Length() >= 1 && args[0]->IsFunction()) {
@@ -1073,7 +1120,8 @@ void BGJSV8Engine::initJNICache() {
     _jniV8JSException.clazz = (jclass) env->NewGlobalRef(env->FindClass("ag/boersego/bgjs/V8JSException"));
     _jniV8JSException.getV8ExceptionId = env->GetMethodID(_jniV8JSException.clazz, "getV8Exception", "()Ljava/lang/Object;");
     _jniV8JSException.initId = env->GetMethodID(_jniV8JSException.clazz, "<init>",
-                                                "(Ljava/lang/String;Ljava/lang/Object;Ljava/lang/Throwable;)V");
+                                                "(Lag/boersego/bgjs/V8Engine;Ljava/lang/String;Ljava/lang/Object;Ljava/lang/Throwable;Ljava/lang/String;I)V");
+    _jniV8JSException.materializeId = env->GetMethodID(_jniV8JSException.clazz, "materialize", "()V");
     _jniV8JSException.setStackTraceId = env->GetMethodID(_jniV8JSException.clazz, "setStackTrace",
                                                          "([Ljava/lang/StackTraceElement;)V");
 
@@ -1084,6 +1132,9 @@ void BGJSV8Engine::initJNICache() {
     _jniStackTraceElement.clazz = (jclass) env->NewGlobalRef(env->FindClass("java/lang/StackTraceElement"));
     _jniStackTraceElement.initId = env->GetMethodID(_jniStackTraceElement.clazz, "<init>",
                                                     "(Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;I)V");
+    _jniV8LockProfile.clazz = (jclass) env->NewGlobalRef(env->FindClass("ag/boersego/bgjs/V8LockProfile"));
+    _jniV8LockProfile.initId = env->GetMethodID(_jniV8LockProfile.clazz, "<init>",
+                                                "(Ljava/lang/String;JJJJJJ[J[J)V");
     _jniV8Engine.clazz = (jclass) env->NewGlobalRef(env->FindClass("ag/boersego/bgjs/V8Engine"));
     _jniV8Engine.onReadyId = env->GetMethodID(_jniV8Engine.clazz, "onReady", "()V");
     _jniV8Engine.onThrowId = env->GetMethodID(_jniV8Engine.clazz, "onThrow", "(Ljava/lang/RuntimeException;)V");
@@ -1098,6 +1149,8 @@ BGJSV8Engine::BGJSV8Engine(jobject obj, JNIClassInfo *info) : JNIObject(obj, inf
     _isolate = nullptr;
     _isSuspended = false;
     _state = EState::kInitial;
+    _numClassTemplates = 0;
+    _minLogLevel = LOG_DEBUG;
 
     // create uv loop, async events, mutexes & conditions
     // these are required for synchronization and dispatching events before the engine is actually started
@@ -1116,8 +1169,20 @@ BGJSV8Engine::BGJSV8Engine(jobject obj, JNIClassInfo *info) : JNIObject(obj, inf
     uv_async_init(&_uvLoop, &_uvEventJniRunnables, &BGJSV8Engine::OnJniRunnables);
     _uvEventJniRunnables.data = this;
 
+    _releasedObjects = nullptr;
+    _pendingExternalMemory = 0;
+    for (auto &externalMemory : _externalMemory) {
+        externalMemory = 0;
+    }
+    uv_async_init(&_uvLoop, &_uvEventReleaseObjects, &BGJSV8Engine::OnReleaseObjects);
+    _uvEventReleaseObjects.data = this;
+
     uv_mutex_init(&_uvMutexRunnables);
 
+    uv_async_init(&_uvLoop, &_uvEventPromiseSettlements, &BGJSV8Engine::OnPromiseSettlements);
+    _uvEventPromiseSettlements.data = this;
+    uv_mutex_init(&_uvMutexPromiseSettlements);
+
     uv_mutex_init(&_uvMutex);
     uv_cond_init(&_uvCondSuspend);
 
@@ -1128,17 +1193,32 @@ const BGJSV8Engine::EState BGJSV8Engine::getState() const {
 }
 
 void BGJSV8Engine::initializeJNIBindings(JNIClassInfo *info, bool isReload) {
-    info->registerNativeMethod("initialize", "(Landroid/content/res/AssetManager;Ljava/lang/String;I)V", (void*)BGJSV8Engine::jniInitialize);
+    info->registerNativeMethod("initialize", "(Landroid/content/res/AssetManager;Ljava/lang/String;IZJ)V", (void*)BGJSV8Engine::jniInitialize);
     info->registerNativeMethod("pause", "()V", (void*)BGJSV8Engine::jniPause);
     info->registerNativeMethod("unpause", "()V", (void*)BGJSV8Engine::jniUnpause);
     info->registerNativeMethod("shutdown", "()V", (void*)BGJSV8Engine::jniShutdown);
     info->registerNativeMethod("dumpHeap", "(Ljava/lang/String;)Ljava/lang/String;", (void*)BGJSV8Engine::jniDumpHeap);
     info->registerNativeMethod("logHeapStats", "()V", (void *) BGJSV8Engine::jniLogHeapStats);
+    info->registerNativeMethod("getNumClassTemplates", "()I", (void *) BGJSV8Engine::jniGetNumClassTemplates);
+    info->registerNativeMethod("_getExternalMemory", "(I)J", (void *) BGJSV8Engine::jniGetExternalMemory);
+    info->registerNativeMethod("setMinLogLevel", "(I)V", (void *) BGJSV8Engine::jniSetMinLogLevel);
+    info->registerNativeMethod("setLogFile", "(Ljava/lang/String;)V", (void *) BGJSV8Engine::jniSetLogFile);
+    info->registerNativeMethod("materializeStackTrace", "(Lag/boersego/bgjs/V8JSException;Ljava/lang/Object;Ljava/lang/String;IZ)Z",
+                               (void *) BGJSV8Engine::jniMaterializeStackTrace);
+    info->registerNativeMethod("getArrayBufferLiveBytes", "()J", (void *) BGJSV8Engine::jniGetArrayBufferLiveBytes);
+    info->registerNativeMethod("getArrayBufferCachedBytes", "()J", (void *) BGJSV8Engine::jniGetArrayBufferCachedBytes);
+    info->registerNativeMethod("setLockProfilingEnabled", "(Z)V", (void *) BGJSV8Engine::jniSetLockProfilingEnabled);
+    info->registerNativeMethod("getLockProfile", "()[Lag/boersego/bgjs/V8LockProfile;", (void *) BGJSV8Engine::jniGetLockProfile);
+    info->registerNativeMethod("resetLockProfile", "()V", (void *) BGJSV8Engine::jniResetLockProfile);
     info->registerNativeMethod("enqueueOnNextTick", "(Ljava/lang/Runnable;)V", (void*)BGJSV8Engine::jniEnqueueOnNextTick);
     info->registerNativeMethod("parseJSON", "(Ljava/lang/String;)Ljava/lang/Object;", (void*)BGJSV8Engine::jniParseJSON);
+    info->registerNativeMethod("createV8Graph", "(Ljava/lang/Object;)Ljava/lang/Object;", (void*)BGJSV8Engine::jniCreateV8Graph);
+    info->registerNativeMethod("_deserialize", "(Ljava/nio/ByteBuffer;II[Ljava/lang/Object;)Ljava/lang/Object;", (void*)BGJSV8Engine::jniDeserialize);
     info->registerNativeMethod("require", "(Ljava/lang/String;)Ljava/lang/Object;", (void*)BGJSV8Engine::jniRequire);
     info->registerNativeMethod("lock", "(Ljava/lang/String;)J", (void*)BGJSV8Engine::jniLock);
     info->registerNativeMethod("unlock", "(J)V", (void*)BGJSV8Engine::jniUnlock);
+    info->registerNativeMethod("openSession", "(Ljava/lang/String;)J", (void*)BGJSV8Engine::jniOpenSession);
+    info->registerNativeMethod("closeSession", "(J)V", (void*)BGJSV8Engine::jniCloseSession);
     info->registerNativeMethod("getGlobalObject", "()Lag/boersego/bgjs/JNIV8GenericObject;", (void*)BGJSV8Engine::jniGetGlobalObject);
     info->registerNativeMethod("runScript", "(Ljava/lang/String;Ljava/lang/String;)Ljava/lang/Object;", (void*)BGJSV8Engine::jniRunScript);
     info->registerNativeMethod("registerModuleNative", "(Lag/boersego/bgjs/JNIV8Module;)V", (void*)BGJSV8Engine::jniRegisterModuleNative);
@@ -1162,8 +1242,12 @@ void BGJSV8Engine::createContext() {
     }
 
     v8::Isolate::CreateParams create_params;
-    create_params.array_buffer_allocator =
-            v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+    if (_arrayBufferAllocator) {
+        create_params.array_buffer_allocator_shared = _arrayBufferAllocator;
+    } else {
+        create_params.array_buffer_allocator =
+                v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+    }
 
     _isolate = v8::Isolate::New(create_params);
     _isolate->SetMicrotasksPolicy(v8::MicrotasksPolicy::kScoped);
@@ -1295,6 +1379,10 @@ void BGJSV8Engine::createContext() {
         _getStackTraceFn.Reset(_isolate, getStackTraceFn_);
     }
 
+    // Init private key for caching wrapper objects
+    _wrapperCacheKey.Reset(_isolate, Private::ForApi(_isolate, String::NewFromOneByte(_isolate, (const uint8_t *) "JNIV8WrapperPrivate",
+                                                                                      NewStringType::kInternalized).ToLocalChecked()));
+
     // Init json parse binding
     {
         Local<Function> jsonParseMethod_ =
@@ -1362,6 +1450,9 @@ void BGJSV8Engine::start(const Options* options) {
     _javaAssetManager = env->NewGlobalRef(options->assetManager);
     _maxHeapSize = options->maxHeapSize;
     _commonJSPath = options->commonJSPath;
+    if (options->pooledArrayBuffers) {
+        _arrayBufferAllocator = std::make_shared<BGJSArrayBufferAllocator>(options->maxCachedArrayBufferBytes);
+    }
 
     // create dedicated looper thread
     uv_thread_create(&_uvThread, &BGJSV8Engine::StartLoopThread, this);
@@ -1612,6 +1703,11 @@ void BGJSV8Engine::UncaughtExceptionHandler(v8::Local<v8::Message> message, v8::
 }
 
 void BGJSV8Engine::log(int debugLevel, const v8::FunctionCallbackInfo<v8::Value> &args) {
+    // filter before converting anything, so that disabled log calls are almost free
+    if (!isLogLevelEnabled(debugLevel)) {
+        return;
+    }
+
     V8Locker locker(args.GetIsolate(), __FUNCTION__);
     HandleScope scope(args.GetIsolate());
 
@@ -1621,7 +1717,11 @@ void BGJSV8Engine::log(int debugLevel, const v8::FunctionCallbackInfo<v8::Value>
         str << " " << toDebugString(args[i]);
     }
 
-    LOG(debugLevel, "%s", str.str().c_str());
+    BGJSLogWriter::write(debugLevel, LOG_TAG, str.str());
+}
+
+void BGJSV8Engine::setMinLogLevel(int level) {
+    _minLogLevel = level;
 }
 
 char *BGJSV8Engine::loadFile(const char *path, unsigned int *length) const {
@@ -1655,13 +1755,27 @@ char *BGJSV8Engine::loadFile(const char *path, unsigned int *length) const {
 BGJSV8Engine::~BGJSV8Engine() {
     LOGI("Cleaning up");
 
+    // objects collected after the event loop ended are still waiting for their release
+    releaseObjects();
+
     uv_loop_close(&_uvLoop);
     uv_close((uv_handle_t*)&_uvEventScheduleTimers, &BGJSV8Engine::OnHandleClosed);
     uv_close((uv_handle_t*)&_uvEventStop, &BGJSV8Engine::OnHandleClosed);
     uv_close((uv_handle_t*)&_uvEventJniRunnables, &BGJSV8Engine::OnHandleClosed);
+    uv_close((uv_handle_t*)&_uvEventReleaseObjects, &BGJSV8Engine::OnHandleClosed);
+    uv_close((uv_handle_t*)&_uvEventPromiseSettlements, &BGJSV8Engine::OnHandleClosed);
     uv_mutex_destroy(&_uvMutexRunnables);
 
     JNIEnv *env = JNIWrapper::getEnvironment();
+
+    // promises that were queued after the event loop ended are never settled
+    for (auto &settlement : _promiseSettlements) {
+        env->DeleteGlobalRef(settlement.resolver);
+        if (settlement.value) env->DeleteGlobalRef(settlement.value);
+    }
+    _promiseSettlements.clear();
+    uv_mutex_destroy(&_uvMutexPromiseSettlements);
+
     env->DeleteGlobalRef(_javaAssetManager);
 
     // clear persistent references
@@ -1672,6 +1786,7 @@ BGJSV8Engine::~BGJSV8Engine() {
     _jsonStringifyFn.Reset();
     _makeJavaErrorFn.Reset();
     _getStackTraceFn.Reset();
+    _wrapperCacheKey.Reset();
 
     _isolate->Exit();
 
@@ -1683,6 +1798,10 @@ BGJSV8Engine::~BGJSV8Engine() {
 }
 
 void BGJSV8Engine::trace(const FunctionCallbackInfo<Value> &args) {
+    if (!isLogLevelEnabled(LOG_INFO)) {
+        return;
+    }
+
     V8Locker locker(args.GetIsolate(), __FUNCTION__);
     HandleScope scope(args.GetIsolate());
 
@@ -1701,7 +1820,7 @@ void BGJSV8Engine::trace(const FunctionCallbackInfo<Value> &args) {
             << JNIV8Marshalling::v8string2string(frame->GetFunctionName()) << ":" << frame->GetLineNumber() << ")\n";
     }
 
-    LOG(LOG_INFO, "%s", str.str().c_str());
+    BGJSLogWriter::write(LOG_INFO, LOG_TAG, str.str());
 }
 
 /**
@@ -1723,12 +1842,12 @@ void BGJSV8Engine::doAssert(const FunctionCallbackInfo<Value> &args) {
 
     Local<Boolean> assertion = args[0]->ToBoolean(isolate);
 
-    if (!assertion->Value()) {
+    if (!assertion->Value() && isLogLevelEnabled(LOG_ERROR)) {
         if (args.Length() > 1) {
             const std::string assertionMessage = toDebugString(args[1]);
-            LOG(LOG_ERROR, "Assertion failed: %s", assertionMessage.c_str());
+            BGJSLogWriter::write(LOG_ERROR, LOG_TAG, "Assertion failed: " + assertionMessage);
         } else {
-            LOG(LOG_ERROR, "Assertion failed");
+            BGJSLogWriter::write(LOG_ERROR, LOG_TAG, "Assertion failed");
         }
 
         std::stringstream str;
@@ -1742,7 +1861,7 @@ void BGJSV8Engine::doAssert(const FunctionCallbackInfo<Value> &args) {
                 << ")\n";
         }
 
-        LOG(LOG_ERROR, "%s", str.str().c_str());
+        BGJSLogWriter::write(LOG_ERROR, LOG_TAG, str.str());
 
     }
 }
@@ -1829,7 +1948,8 @@ const char *BGJSV8Engine::enqueueMemoryDump(const char *basePath) {
 }
 
 void BGJSV8Engine::jniInitialize(
-        JNIEnv * env, jobject v8Engine, jobject assetManager, jstring commonJSPath, jint maxHeapSize) {
+        JNIEnv * env, jobject v8Engine, jobject assetManager, jstring commonJSPath, jint maxHeapSize,
+        jboolean pooledArrayBuffers, jlong maxCachedArrayBufferBytes) {
 
     auto ct = JNIV8Wrapper::wrapObject<BGJSV8Engine>(v8Engine);
 
@@ -1837,6 +1957,8 @@ void BGJSV8Engine::jniInitialize(
     options.assetManager = assetManager;
     options.commonJSPath = env->GetStringUTFChars(commonJSPath, nullptr);
     options.maxHeapSize = maxHeapSize;
+    options.pooledArrayBuffers = pooledArrayBuffers;
+    options.maxCachedArrayBufferBytes = maxCachedArrayBufferBytes > 0 ? (size_t)maxCachedArrayBufferBytes : 0;
 
     ct->start(&options);
 
@@ -1886,6 +2008,102 @@ void BGJSV8Engine::jniLogHeapStats(JNIEnv *env, jobject obj) {
     LOGD("dada used_heap_size: %zu", v8_heap_stats.used_heap_size());
     LOGD("dada heap_size_limit: %zu", v8_heap_stats.heap_size_limit());
     LOGD("dada total_available_size: %zu", v8_heap_stats.total_available_size());
+    LOGD("dada class_templates: %u", engine->getNumClassTemplates());
+    LOGD("dada external_heap: %lld", (long long)engine->getExternalMemory(BGJSExternalMemoryType::kHeap));
+    LOGD("dada external_gpu: %lld", (long long)engine->getExternalMemory(BGJSExternalMemoryType::kGPU));
+    LOGD("dada array_buffer_live: %lld", (long long)engine->getArrayBufferLiveBytes());
+    LOGD("dada array_buffer_cached: %lld", (long long)engine->getArrayBufferCachedBytes());
+}
+
+jlong BGJSV8Engine::jniGetExternalMemory(JNIEnv *env, jobject obj, jint type) {
+    auto engine = JNIWrapper::wrapObject<BGJSV8Engine>(obj);
+    if (type < 0 || type >= (jint)BGJSExternalMemoryType::kCount) {
+        env->ThrowNew(env->FindClass("java/lang/IllegalArgumentException"), "Invalid external memory type");
+        return 0;
+    }
+    return (jlong)engine->getExternalMemory((BGJSExternalMemoryType)type);
+}
+
+jlong BGJSV8Engine::jniGetArrayBufferLiveBytes(JNIEnv *env, jobject obj) {
+    auto engine = JNIWrapper::wrapObject<BGJSV8Engine>(obj);
+    return (jlong)engine->getArrayBufferLiveBytes();
+}
+
+jlong BGJSV8Engine::jniGetArrayBufferCachedBytes(JNIEnv *env, jobject obj) {
+    auto engine = JNIWrapper::wrapObject<BGJSV8Engine>(obj);
+    return (jlong)engine->getArrayBufferCachedBytes();
+}
+
+void BGJSV8Engine::jniSetLockProfilingEnabled(JNIEnv *env, jobject obj, jboolean enabled) {
+    BGJSLockProfiler::setEnabled(enabled);
+}
+
+static jlongArray createHistogramArray(JNIEnv *env, const std::atomic<uint32_t> *histogram) {
+    jlong values[BGJSLockSite::kNumBuckets];
+    for (int i = 0; i < BGJSLockSite::kNumBuckets; i++) {
+        values[i] = histogram[i].load(std::memory_order_relaxed);
+    }
+    jlongArray array = env->NewLongArray(BGJSLockSite::kNumBuckets);
+    env->SetLongArrayRegion(array, 0, BGJSLockSite::kNumBuckets, values);
+    return array;
+}
+
+jobjectArray BGJSV8Engine::jniGetLockProfile(JNIEnv *env, jobject obj) {
+    int numSites;
+    BGJSLockSite *sites = BGJSLockProfiler::getSites(&numSites);
+
+    std::vector<BGJSLockSite*> usedSites;
+    for (int i = 0; i < numSites; i++) {
+        if (sites[i].ownerName.load(std::memory_order_acquire) && sites[i].numAcquires.load(std::memory_order_relaxed)) {
+            usedSites.push_back(&sites[i]);
+        }
+    }
+
+    jobjectArray result = env->NewObjectArray((jsize)usedSites.size(), _jniV8LockProfile.clazz, nullptr);
+    for (size_t i = 0; i < usedSites.size(); i++) {
+        BGJSLockSite *site = usedSites[i];
+        jstring ownerName = env->NewStringUTF(site->ownerName.load(std::memory_order_relaxed));
+        jlongArray waitHistogram = createHistogramArray(env, site->waitHistogram);
+        jlongArray holdHistogram = createHistogramArray(env, site->holdHistogram);
+        jobject profile = env->NewObject(_jniV8LockProfile.clazz, _jniV8LockProfile.initId, ownerName,
+                                         (jlong)site->numAcquires.load(std::memory_order_relaxed),
+                                         (jlong)site->numRecursiveAcquires.load(std::memory_order_relaxed),
+                                         (jlong)site->totalWaitTime.load(std::memory_order_relaxed),
+                                         (jlong)site->maxWaitTime.load(std::memory_order_relaxed),
+                                         (jlong)site->totalHoldTime.load(std::memory_order_relaxed),
+                                         (jlong)site->maxHoldTime.load(std::memory_order_relaxed),
+                                         waitHistogram, holdHistogram);
+        env->SetObjectArrayElement(result, (jsize)i, profile);
+        env->DeleteLocalRef(profile);
+        env->DeleteLocalRef(holdHistogram);
+        env->DeleteLocalRef(waitHistogram);
+        env->DeleteLocalRef(ownerName);
+    }
+    return result;
+}
+
+void BGJSV8Engine::jniResetLockProfile(JNIEnv *env, jobject obj) {
+    BGJSLockProfiler::reset();
+}
+
+void BGJSV8Engine::jniSetMinLogLevel(JNIEnv *env, jobject obj, jint level) {
+    auto engine = JNIWrapper::wrapObject<BGJSV8Engine>(obj);
+    engine->setMinLogLevel(level);
+}
+
+void BGJSV8Engine::jniSetLogFile(JNIEnv *env, jobject obj, jstring path) {
+    if (!path) {
+        BGJSLogWriter::setFile(nullptr);
+        return;
+    }
+    const char *pathStr = env->GetStringUTFChars(path, nullptr);
+    BGJSLogWriter::setFile(pathStr);
+    env->ReleaseStringUTFChars(path, pathStr);
+}
+
+jint BGJSV8Engine::jniGetNumClassTemplates(JNIEnv *env, jobject obj) {
+    auto engine = JNIWrapper::wrapObject<BGJSV8Engine>(obj);
+    return (jint)engine->getNumClassTemplates();
 }
 
 void BGJSV8Engine::jniEnqueueOnNextTick(JNIEnv* env, jobject obj, jobject runnable) {
@@ -1924,6 +2142,136 @@ void BGJSV8Engine::OnJniRunnables(uv_async_t* handle) {
     }
 }
 
+void BGJSV8Engine::enqueuePromiseSettlement(jobject resolver, jobject value, bool reject) {
+    JNIEnv *env = JNIWrapper::getEnvironment();
+
+    PromiseSettlement settlement;
+    settlement.resolver = env->NewGlobalRef(resolver);
+    settlement.value = value ? env->NewGlobalRef(value) : nullptr;
+    settlement.reject = reject;
+
+    uv_mutex_lock(&_uvMutexPromiseSettlements);
+    const bool wasEmpty = _promiseSettlements.empty();
+    _promiseSettlements.push_back(settlement);
+    uv_mutex_unlock(&_uvMutexPromiseSettlements);
+
+    // the event loop only has to be woken up for the first promise of a batch
+    if (wasEmpty) {
+        uv_async_send(&_uvEventPromiseSettlements);
+    }
+}
+
+void BGJSV8Engine::OnPromiseSettlements(uv_async_t* handle) {
+    auto* engine = (BGJSV8Engine*) handle->data;
+    engine->settlePromises();
+}
+
+void BGJSV8Engine::settlePromises() {
+    std::vector<PromiseSettlement> settlements;
+    uv_mutex_lock(&_uvMutexPromiseSettlements);
+    settlements.swap(_promiseSettlements);
+    uv_mutex_unlock(&_uvMutexPromiseSettlements);
+
+    if (settlements.empty()) return;
+
+    JNIEnv *env = JNIWrapper::getEnvironment();
+    {
+        // settle everything under one lock; reactions run in a single microtask checkpoint when the session ends
+        V8Session session(this, __FUNCTION__);
+        for (auto &settlement : settlements) {
+            HandleScope scope(_isolate);
+            v8::TryCatch try_catch(_isolate);
+            if (!JNIV8PromiseResolver::settle(settlement.resolver, settlement.value, settlement.reject)) {
+                forwardV8ExceptionToJNI(&try_catch, true);
+            }
+        }
+    }
+
+    for (auto &settlement : settlements) {
+        env->DeleteGlobalRef(settlement.resolver);
+        if (settlement.value) env->DeleteGlobalRef(settlement.value);
+    }
+}
+
+void BGJSV8Engine::enqueueObjectRelease(JNIV8Object *object) {
+    // called from the gc: must neither lock nor allocate
+    // an object that is still linked (because it was relinked and collected again before its release was processed)
+    // is not pushed a second time; the release is only counted
+    if (object->_numPendingReleases.fetch_add(1) > 0) {
+        return;
+    }
+
+    JNIV8Object *head = _releasedObjects.load(std::memory_order_relaxed);
+    do {
+        object->_nextReleasedObject = head;
+    } while (!_releasedObjects.compare_exchange_weak(head, object, std::memory_order_release, std::memory_order_relaxed));
+
+    // the event loop only has to be woken up for the first object of a batch
+    if (!head) {
+        uv_async_send(&_uvEventReleaseObjects);
+    }
+}
+
+void BGJSV8Engine::OnReleaseObjects(uv_async_t* handle) {
+    auto* engine = (BGJSV8Engine*) handle->data;
+    engine->releaseObjects();
+}
+
+void BGJSV8Engine::releaseObjects() {
+    // take the whole list at once; objects queued from now on start a new batch
+    JNIV8Object *object = _releasedObjects.exchange(nullptr, std::memory_order_acquire);
+    int64_t externalMemory = _pendingExternalMemory.exchange(0, std::memory_order_relaxed);
+
+    int64_t releasedMemory = 0;
+    while (object) {
+        // the link has to be read before the counter is reset: from then on, the object can be pushed again
+        JNIV8Object *next = object->_nextReleasedObject;
+        // every counted release balances the retain of one makeWeak call
+        int numReleases = object->_numPendingReleases.exchange(0);
+        for (int i = 0; i < numReleases; i++) {
+            releasedMemory += object->_externalMemory;
+            // NOTE: object might be deleted by another thread after the last call
+            object->releaseJObject();
+        }
+        object = next;
+    }
+    _externalMemory[(size_t)BGJSExternalMemoryType::kHeap].fetch_sub(releasedMemory, std::memory_order_relaxed);
+    externalMemory -= releasedMemory;
+
+    // all changes are reported with a single adjustment
+    if (externalMemory && _isolate) {
+        V8Locker l(_isolate, __FUNCTION__);
+        _isolate->AdjustAmountOfExternalAllocatedMemory(externalMemory);
+    }
+}
+
+void BGJSV8Engine::adjustExternalMemory(BGJSExternalMemoryType type, int64_t change) {
+    if (!change) {
+        return;
+    }
+    _externalMemory[(size_t)type].fetch_add(change, std::memory_order_relaxed);
+
+    // v8 may only be called while the isolate is locked by the current thread
+    if (_isolate && v8::Locker::IsLocked(_isolate)) {
+        _isolate->AdjustAmountOfExternalAllocatedMemory(change);
+    } else {
+        _pendingExternalMemory.fetch_add(change, std::memory_order_relaxed);
+        uv_async_send(&_uvEventReleaseObjects);
+    }
+}
+
+int64_t BGJSV8Engine::getExternalMemory(BGJSExternalMemoryType type) const {
+    return _externalMemory[(size_t)type].load(std::memory_order_relaxed);
+}
+
+int64_t BGJSV8Engine::getArrayBufferLiveBytes() const {
+    return _arrayBufferAllocator ? _arrayBufferAllocator->getLiveBytes() : -1;
+}
+
+int64_t BGJSV8Engine::getArrayBufferCachedBytes() const {
+    return _arrayBufferAllocator ? _arrayBufferAllocator->getCachedBytes() : -1;
+}
+
 jobject BGJSV8Engine::jniParseJSON(JNIEnv *env, jobject obj, jstring json) {
     auto engine = JNIWrapper::wrapObject<BGJSV8Engine>(obj);
     THROW_IF_NOT_STARTED();
@@ -1946,6 +2294,63 @@ jobject BGJSV8Engine::jniParseJSON(JNIEnv *env, jobject obj, jstring json) {
     return JNIV8Marshalling::v8value2jobject(value.ToLocalChecked());
 }
 
+jobject BGJSV8Engine::jniCreateV8Graph(JNIEnv *env, jobject obj, jobject graph) {
+    auto engine = JNIWrapper::wrapObject<BGJSV8Engine>(obj);
+    THROW_IF_NOT_STARTED();
+
+    v8::Isolate *isolate = engine->getIsolate();
+    V8Locker l(isolate, __FUNCTION__);
+    v8::Isolate::Scope isolateScope(isolate);
+    v8::HandleScope scope(isolate);
+    v8::Local<v8::Context> context = engine->getContext();
+    v8::Context::Scope ctxScope(context);
+    v8::MicrotasksScope taskScope(isolate, v8::MicrotasksScope::kRunMicrotasks);
+
+    // the whole graph is converted under a single lock
+    v8::TryCatch try_catch(isolate);
+    v8::Local<v8::Value> valueRef;
+    if (!JNIV8Marshalling::jobjectGraph2v8value(graph).ToLocal(&valueRef)) {
+        engine->forwardV8ExceptionToJNI(&try_catch);
+        return nullptr;
+    }
+
+    return JNIV8Marshalling::v8value2jobject(valueRef);
+}
+
+jobject BGJSV8Engine::jniDeserialize(JNIEnv *env, jobject obj, jobject buffer, jint offset, jint length, jobjectArray hostObjects) {
+    auto engine = JNIWrapper::wrapObject<BGJSV8Engine>(obj);
+    THROW_IF_NOT_STARTED();
+
+    auto data = (const uint8_t*)env->GetDirectBufferAddress(buffer);
+    jlong capacity = env->GetDirectBufferCapacity(buffer);
+    if (!data || capacity < 0) {
+        env->ThrowNew(env->FindClass("java/lang/IllegalArgumentException"), "buffer must be a direct ByteBuffer");
+        return nullptr;
+    }
+    // compared as jlong so that offset + length can not overflow
+    if (offset < 0 || length < 0 || (jlong)offset > capacity || (jlong)length > capacity - (jlong)offset) {
+        env->ThrowNew(env->FindClass("java/lang/IndexOutOfBoundsException"), "offset and length must specify a range within the buffer");
+        return nullptr;
+    }
+
+    v8::Isolate *isolate = engine->getIsolate();
+    V8Locker l(isolate, __FUNCTION__);
+    v8::Isolate::Scope isolateScope(isolate);
+    v8::HandleScope scope(isolate);
+    v8::Local<v8::Context> context = engine->getContext();
+    v8::Context::Scope ctxScope(context);
+    v8::MicrotasksScope taskScope(isolate, v8::MicrotasksScope::kRunMicrotasks);
+
+    v8::TryCatch try_catch(isolate);
+    v8::Local<v8::Value> valueRef;
+    if (!JNIV8Serializer::deserialize(context, data + offset, (size_t)length, hostObjects).ToLocal(&valueRef)) {
+        engine->forwardV8ExceptionToJNI(&try_catch);
+        return nullptr;
+    }
+
+    return JNIV8Marshalling::v8value2jobject(valueRef);
+}
+
 jobject BGJSV8Engine::jniRequire(JNIEnv *env, jobject obj, jstring file) {
     auto engine = JNIWrapper::wrapObject<BGJSV8Engine>(obj);
     THROW_IF_NOT_STARTED();
@@ -2003,6 +2408,71 @@ void BGJSV8Engine::jniUnlock(JNIEnv *env, jobject obj, jlong lockerPtr) {
     delete (locker);
 }
 
+jlong BGJSV8Engine::jniOpenSession(JNIEnv *env, jobject obj, jstring ownerName) {
+    auto engine = JNIWrapper::wrapObject<BGJSV8Engine>(obj);
+    THROW_IF_NOT_STARTED();
+    if (env->ExceptionCheck()) {
+        return 0;
+    }
+
+#ifdef V8_LOCK_LOGGING
+    std::string ownerNameStr = std::string(__FUNCTION__) + ": " + JNIWrapper::jstring2string(ownerName);
+    auto *session = new V8Session(engine.get(), ownerNameStr.c_str());
+#else
+    auto *session = new V8Session(engine.get(), __FUNCTION__);
+#endif
+
+    return (jlong) session;
+}
+
+void BGJSV8Engine::jniCloseSession(JNIEnv *env, jobject obj, jlong sessionPtr) {
+    auto *session = reinterpret_cast<V8Session *>(sessionPtr);
+    if (session) {
+        delete (session);
+    }
+}
+
+//-----------------------------------------------------------
+// V8Session
+//-----------------------------------------------------------
+
+thread_local V8Session *V8Session::_currentSession = nullptr;
+
+V8Session::V8Session(BGJSV8Engine *engine, const char *ownerName) : _engine(engine), _outerSession(_currentSession) {
+    // an outer session for the same engine has already entered everything on this thread
+    if (_outerSession && _outerSession->_engine == engine) {
+        return;
+    }
+
+    v8::Isolate *isolate = engine->getIsolate();
+    _locker.emplace(isolate, ownerName);
+    _isolateScope.emplace(isolate);
+    _handleScope.emplace(isolate);
+    _contextScope.emplace(engine->getContext());
+    _taskScope.emplace(isolate, v8::MicrotasksScope::kRunMicrotasks);
+
+    _currentSession = this;
+}
+
+V8Session::~V8Session() {
+    if (isNested()) {
+        return;
+    }
+
+    // leaving the microtask scope runs all pending microtasks; so this has to happen while everything else is still entered
+    _taskScope.reset();
+    _contextScope.reset();
+    _handleScope.reset();
+    _isolateScope.reset();
+    _locker.reset();
+
+    _currentSession = _outerSession;
+}
+
+bool V8Session::isNested() const {
+    return !_locker.has_value();
+}
+
 jobject BGJSV8Engine::jniRunScript(JNIEnv *env, jobject obj, jstring script, jstring name) {
     auto engine = JNIWrapper::wrapObject<BGJSV8Engine>(obj);
     THROW_IF_NOT_STARTED();
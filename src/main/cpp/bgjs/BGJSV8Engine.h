@@ -6,11 +6,16 @@
 #include <map>
 #include <string>
 #include <set>
+#include <optional>
+#include <atomic>
 #include <mallocdebug.h>
 #include <stdlib.h>
 #include <uv.h>
 
 #include "os-android.h"
+#include "BGJSExternalMemory.h"
+#include "BGJSArrayBufferAllocator.h"
+#include "BGJSLockProfiler.h"
 
 #include "../jni/jni.h"
 
@@ -26,6 +31,8 @@
 //#define V8_LOCK_LOGGING 1
 
 class BGJSGLView;
+class JNIV8ClassInfo;
+class JNIV8Object;
 
 typedef  void (*requireHook) (class BGJSV8Engine* engine, v8::Handle<v8::Object> target);
 
@@ -36,6 +43,7 @@ typedef enum EBGJSV8EngineEmbedderData {
 
 class BGJSV8Engine : public JNIObject {
 	friend class JNIWrapper;
+	friend class JNIV8Wrapper;
 public:
 	enum class EState {
 		kInitial,
@@ -49,6 +57,10 @@ public:
 		jobject assetManager;
 		const char *commonJSPath;
 		int maxHeapSize;
+		// use BGJSArrayBufferAllocator instead of the default allocator for array buffers
+		bool pooledArrayBuffers;
+		// upper limit for the memory kept in free lists by the pooled allocator
+		size_t maxCachedArrayBufferBytes;
 	};
 
 	BGJSV8Engine(jobject obj, JNIClassInfo *info);
@@ -67,6 +79,54 @@ public:
 	v8::Isolate* getIsolate() const;
 	v8::Local<v8::Context> getContext() const;
 
+	/**
+	 * returns the private key used to cache the wrapper object of a js value on the value itself
+	 */
+	v8::Local<v8::Private> getWrapperCacheKey() const;
+
+	/**
+	 * returns the number of bound classes whose templates were built in this engine
+	 * templates are only built when a class is first wrapped, constructed or exposed to js
+	 */
+	uint32_t getNumClassTemplates() const;
+
+	/**
+	 * queues the release of the java object of a JNIV8Object whose js object was collected
+	 * can be called from weak callbacks: does not call into v8 or JNI. Queued objects are released in batches on the
+	 * event loop thread, and their external memory is subtracted with a single adjustment.
+	 */
+	void enqueueObjectRelease(JNIV8Object *object);
+
+	/**
+	 * reports native memory retained by js objects to v8 and adds it to the total of the category
+	 * can be called from any thread: if the isolate is not locked by the calling thread, v8 is informed on the event loop
+	 * prefer BGJSExternalMemory over calling this directly
+	 */
+	void adjustExternalMemory(BGJSExternalMemoryType type, int64_t change);
+
+	/**
+	 * returns the total external memory currently reported for the category
+	 */
+	int64_t getExternalMemory(BGJSExternalMemoryType type) const;
+
+	/**
+	 * queues the resolution or rejection of a promise
+	 * can be called from any thread without locking the isolate; all queued promises are settled in one batch on the
+	 * event loop thread, followed by a single microtask checkpoint
+	 * @param resolver java object of a JNIV8PromiseResolver
+	 */
+	void enqueuePromiseSettlement(jobject resolver, jobject value, bool reject);
+
+	/**
+	 * returns the number of bytes held by live array buffers, or -1 if the pooled allocator is not used
+	 */
+	int64_t getArrayBufferLiveBytes() const;
+
+	/**
+	 * returns the number of bytes cached by the array buffer allocator, or -1 if the pooled allocator is not used
+	 */
+	int64_t getArrayBufferCachedBytes() const;
+
 	bool forwardJNIExceptionToV8() const;
 	bool forwardV8ExceptionToJNI(v8::TryCatch* try_catch, bool throwOnMainThread = true) const;
 	bool forwardJNIExceptionToJNIMainThread() const;
@@ -92,6 +152,14 @@ public:
 	void log(int level, const v8::FunctionCallbackInfo<v8::Value>& args);
 	void doAssert(const v8::FunctionCallbackInfo<v8::Value> &info);
 
+	/**
+	 * console messages below the specified android log priority are discarded before their arguments are converted
+	 */
+	void setMinLogLevel(int level);
+	bool isLogLevelEnabled(int level) const {
+		return level >= _minLogLevel.load(std::memory_order_relaxed);
+	}
+
 	void pause();
 	void unpause();
 
@@ -124,8 +192,16 @@ private:
 		jobject runnable;
 	};
 
+	struct PromiseSettlement {
+		jobject resolver;
+		jobject value;
+		bool reject;
+	};
+
 	uint64_t createTimer(v8::Local<v8::Function> callback, uint64_t delay, uint64_t repeat);
 	bool forwardV8ExceptionToJNI(std::string messagePrefix, v8::Local<v8::Value> exception, v8::Local<v8::Message> message, bool throwOnMainThread = false) const;
+	jstring createExceptionMessage(const std::string &messagePrefix, v8::Local<v8::Value> exception, jstring fileName, jint lineNumber) const;
+	jobjectArray createJavaStackTrace(v8::Local<v8::Value> exception, jstring fileName, jint lineNumber) const;
 
 	// utility method to convert v8 values to readable strings for debugging
 	const std::string toDebugString(v8::Handle<v8::Value> source) const;
@@ -154,22 +230,42 @@ private:
 	static void OnTimerEventCallback(uv_async_t * handle);
 	static void RejectedPromiseHolderWeakPersistentCallback(const v8::WeakCallbackInfo<void> &data);
 	static void OnJniRunnables(uv_async_t* handle);
+	static void OnReleaseObjects(uv_async_t* handle);
+	static void OnPromiseSettlements(uv_async_t* handle);
+	void settlePromises();
+	void releaseObjects();
 
 	void createContext();
 
 	// jni methods
-    static void jniInitialize(JNIEnv * env, jobject v8Engine, jobject assetManager, jstring commonJSPath, jint maxHeapSize);
+    static void jniInitialize(JNIEnv * env, jobject v8Engine, jobject assetManager, jstring commonJSPath, jint maxHeapSize,
+                              jboolean pooledArrayBuffers, jlong maxCachedArrayBufferBytes);
     static void jniPause(JNIEnv *env, jobject obj);
     static void jniUnpause(JNIEnv *env, jobject obj);
     static void jniShutdown(JNIEnv *env, jobject obj);
     static jstring jniDumpHeap(JNIEnv *env, jobject obj, jstring pathToSaveIn);
 	static void jniLogHeapStats(JNIEnv *env, jobject obj);
+	static jint jniGetNumClassTemplates(JNIEnv *env, jobject obj);
+	static jlong jniGetExternalMemory(JNIEnv *env, jobject obj, jint type);
+	static void jniSetMinLogLevel(JNIEnv *env, jobject obj, jint level);
+	static void jniSetLogFile(JNIEnv *env, jobject obj, jstring path);
+	static jboolean jniMaterializeStackTrace(JNIEnv *env, jobject obj, jobject exception, jobject v8Exception,
+											 jstring fileName, jint lineNumber, jboolean wait);
+	static jlong jniGetArrayBufferLiveBytes(JNIEnv *env, jobject obj);
+	static jlong jniGetArrayBufferCachedBytes(JNIEnv *env, jobject obj);
+	static void jniSetLockProfilingEnabled(JNIEnv *env, jobject obj, jboolean enabled);
+	static jobjectArray jniGetLockProfile(JNIEnv *env, jobject obj);
+	static void jniResetLockProfile(JNIEnv *env, jobject obj);
 	static void jniEnqueueOnNextTick(JNIEnv *env, jobject obj, jobject runnable);
     static jobject jniParseJSON(JNIEnv *env, jobject obj, jstring json);
+    static jobject jniCreateV8Graph(JNIEnv *env, jobject obj, jobject graph);
+    static jobject jniDeserialize(JNIEnv *env, jobject obj, jobject buffer, jint offset, jint length, jobjectArray hostObjects);
     static jobject jniRequire(JNIEnv *env, jobject obj, jstring file);
     static jlong jniLock(JNIEnv *env, jobject obj, jstring ownerName);
     static jobject jniGetGlobalObject(JNIEnv *env, jobject obj);
     static void jniUnlock(JNIEnv *env, jobject obj, jlong lockerPtr);
+    static jlong jniOpenSession(JNIEnv *env, jobject obj, jstring ownerName);
+    static void jniCloseSession(JNIEnv *env, jobject obj, jlong sessionPtr);
     static jobject jniRunScript(JNIEnv *env, jobject obj, jstring script, jstring name);
     static void jniRegisterModuleNative(JNIEnv *env, jobject obj, jobject module);
     static jobject jniGetConstructor(JNIEnv *env, jobject obj, jstring canonicalName);
@@ -186,6 +282,7 @@ private:
 		jmethodID initId;
 		jmethodID setStackTraceId;
 		jmethodID getV8ExceptionId;
+		jmethodID materializeId;
 	} _jniV8JSException;
 
 	static struct {
@@ -198,6 +295,11 @@ private:
 		jmethodID initId;
 	} _jniStackTraceElement;
 
+	static struct {
+		jclass clazz;
+		jmethodID initId;
+	} _jniV8LockProfile;
+
 	static struct {
 		jclass clazz;
 		jmethodID onReadyId;
@@ -217,10 +319,23 @@ private:
 	uv_async_t _uvEventScheduleTimers, _uvEventStop, _uvEventSuspend;
 
 	uv_async_t _uvEventJniRunnables;
+	uv_async_t _uvEventReleaseObjects;
+	// lock-free stack of objects waiting for release (linked via JNIV8Object::_nextReleasedObject)
+	// an object is only linked once; if it is collected again before it is released, only its counter is increased
+	std::atomic<JNIV8Object*> _releasedObjects;
+	// external memory changes that could not be reported to v8 yet, because the isolate was not locked
+	std::atomic<int64_t> _pendingExternalMemory;
+	std::atomic<int64_t> _externalMemory[(size_t)BGJSExternalMemoryType::kCount];
 	std::vector<RunnableHolder*> _nextTickRunnables;
 	uv_mutex_t _uvMutexRunnables;
 
+	uv_async_t _uvEventPromiseSettlements;
+	std::vector<PromiseSettlement> _promiseSettlements;
+	uv_mutex_t _uvMutexPromiseSettlements;
+
 	int _maxHeapSize;	// in MB
+	// only set if the engine was started with pooledArrayBuffers; shared with v8, which keeps it alive for its backing stores
+	std::shared_ptr<BGJSArrayBufferAllocator> _arrayBufferAllocator;
 
     uint8_t _nextEmbedderDataIndex;
 	jobject _javaAssetManager;
@@ -245,6 +360,13 @@ private:
 	v8::Persistent<v8::Function> _debugDumpFn;
 	v8::Persistent<v8::Function> _makeJavaErrorFn;
 	v8::Persistent<v8::Function> _getStackTraceFn;
+	v8::Persistent<v8::Private> _wrapperCacheKey;
+
+	// class infos of this engine indexed by class id; only accessed while holding the isolate lock
+	std::vector<JNIV8ClassInfo*> _classInfos;
+	// number of entries in _classInfos; can be read from any thread
+	std::atomic<uint32_t> _numClassTemplates;
+	std::atomic<int> _minLogLevel;
 
     v8::Local<v8::Function> makeRequireFunction(std::string pathName);
 };
@@ -364,11 +486,50 @@ public:
 #undef LOG_TAG
 #else // V8_LOCK_LOGGING
 
-class V8Locker : public v8::Locker {
+/**
+ * Locks an isolate
+ * If lock profiling is enabled (see BGJSLockProfiler), the time spent waiting for and holding the lock is recorded
+ * for the owner name, which has to be a static string. Builds with V8_LOCK_LOGGING pass temporary owner names and are
+ * not profiled.
+ */
+class V8Locker : private BGJSLockSample, public v8::Locker {
 public:
-    V8Locker(v8::Isolate* isolate, const char* ownerName) : v8::Locker(isolate) {}
+    V8Locker(v8::Isolate* isolate, const char* ownerName) : BGJSLockSample(isolate, ownerName), v8::Locker(isolate) {
+        acquired();
+    }
+    ~V8Locker() {
+        released();
+    }
 };
 
 #endif // V8_LOCK_LOGGING
 
+/**
+ * Enters an engine: locks the isolate and opens isolate, handle, context and microtask scopes
+ *
+ * Sessions can be nested: if a session for the same engine is already active on the current thread,
+ * a new session does not enter anything again. Microtasks are only run once when the outermost session is left.
+ * Sessions have to be destroyed in reverse order of creation on the thread that created them.
+ */
+class V8Session {
+public:
+	V8Session(BGJSV8Engine *engine, const char *ownerName);
+	~V8Session();
+
+	/**
+	 * returns true if this session did not enter the engine because an outer session already did
+	 */
+	bool isNested() const;
+private:
+	BGJSV8Engine *_engine;
+	V8Session *_outerSession;
+	std::optional<V8Locker> _locker;
+	std::optional<v8::Isolate::Scope> _isolateScope;
+	std::optional<v8::HandleScope> _handleScope;
+	std::optional<v8::Context::Scope> _contextScope;
+	std::optional<v8::MicrotasksScope> _taskScope;
+
+	static thread_local V8Session *_currentSession;
+};
+
 #endif
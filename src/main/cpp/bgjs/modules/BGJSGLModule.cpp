@@ -142,8 +142,19 @@ BGJSCanvasGL::~BGJSCanvasGL() {
     }
 }
 
-v8::Persistent<v8::Function> BGJSGLModule::g_classRefCanvasGL;
-v8::Persistent<v8::Function> BGJSGLModule::g_classRefContext2dGL;
+v8::Local<v8::Private> BGJSGLModule::getClassRefKey(v8::Isolate* isolate, const char* name) {
+	return v8::Private::ForApi(isolate, String::NewFromUtf8(isolate, name).ToLocalChecked());
+}
+
+v8::MaybeLocal<v8::Function> BGJSGLModule::getClassRef(v8::Local<v8::Context> context, const char* name) {
+	v8::Isolate* isolate = context->GetIsolate();
+	v8::EscapableHandleScope scope(isolate);
+	v8::Local<v8::Value> value;
+	if (!context->Global()->GetPrivate(context, getClassRefKey(isolate, name)).ToLocal(&value) || !value->IsFunction()) {
+		return v8::MaybeLocal<v8::Function>();
+	}
+	return scope.Escape(value.As<v8::Function>());
+}
 
 void js_context_get_fillStyle(Local<String> property,
 		const v8::PropertyCallbackInfo<Value>& info) {
@@ -995,7 +1006,12 @@ void BGJSGLModule::js_canvas_constructor(const v8::FunctionCallbackInfo<v8::Valu
 	BGJSCanvasGL* canvas = new BGJSCanvasGL();
 	canvas->_view = JNIRetainedRef<BGJSGLView>::New(JNIV8Wrapper::wrapObject<BGJSGLView>(args[0]->ToObject(isolate->GetCurrentContext()).ToLocalChecked()));
 
-	MaybeLocal<Object> fn = Local<Function>::New(isolate, BGJSGLModule::g_classRefCanvasGL)->NewInstance(BGJSV8Engine::GetInstance(isolate)->getContext());
+	Local<Context> context = BGJSV8Engine::GetInstance(isolate)->getContext();
+	Local<Function> classRef;
+	MaybeLocal<Object> fn;
+	if (getClassRef(context, kClassRefCanvasGL).ToLocal(&classRef)) {
+		fn = classRef->NewInstance(context);
+	}
     if (fn.IsEmpty()) {
         LOGE("js_canvas_constructor cannot create BGJSGLModule instance");
         args.GetReturnValue().SetUndefined();
@@ -1028,8 +1044,12 @@ void BGJSGLModule::js_canvas_getContext(const v8::FunctionCallbackInfo<v8::Value
 	}
 
 	BGJSV8Engine2dGL *context2d = new BGJSV8Engine2dGL();
-	Local<Function> gClassRefLocal = *reinterpret_cast<Local<Function>*>(&BGJSGLModule::g_classRefContext2dGL);
-	MaybeLocal<Object> jsObj = gClassRefLocal->NewInstance(BGJSV8Engine::GetInstance(isolate)->getContext());
+	Local<Context> context = BGJSV8Engine::GetInstance(isolate)->getContext();
+	Local<Function> classRef;
+	MaybeLocal<Object> jsObj;
+	if (getClassRef(context, kClassRefContext2dGL).ToLocal(&classRef)) {
+		jsObj = classRef->NewInstance(context);
+	}
     if (jsObj.IsEmpty()) {
         LOGE("js_canvas_constructor cannot create BGJSGLModule:context2d instance");
         args.GetReturnValue().SetUndefined();
@@ -1070,7 +1090,8 @@ void BGJSGLModule::doRequire(BGJSV8Engine* engine, v8::Handle<v8::Object> target
 
 	// bgjsgl->Set(String::NewFromUtf8(isolate, "log"), FunctionTemplate::New(BGJSGLModule::log));
 	Local<Function> instance = bgjshtmlft->GetFunction(isolate->GetCurrentContext()).ToLocalChecked();
-	BGJS_RESET_PERSISTENT(isolate, BGJSGLModule::g_classRefCanvasGL, instance);
+	Local<Context> context = isolate->GetCurrentContext();
+	context->Global()->SetPrivate(context, getClassRefKey(isolate, kClassRefCanvasGL), instance);
 	MaybeLocal<Object> exports = instance->NewInstance(BGJSV8Engine::GetInstance(isolate)->getContext());
 
 	// Create the template for Canvas objects
@@ -1172,8 +1193,8 @@ void BGJSGLModule::doRequire(BGJSV8Engine* engine, v8::Handle<v8::Object> target
 	canvasot->Set(String::NewFromUtf8(isolate, "clipY").ToLocalChecked(),
 			FunctionTemplate::New(isolate, js_context_clipY));
 
-	BGJS_RESET_PERSISTENT(isolate, g_classRefContext2dGL, canvasft->GetFunction(isolate->GetCurrentContext()).ToLocalChecked());
-	// g_classRefContext2dGL
+	context->Global()->SetPrivate(context, getClassRefKey(isolate, kClassRefContext2dGL),
+			canvasft->GetFunction(context).ToLocalChecked());
 
 	target->Set(isolate->GetCurrentContext(), String::NewFromUtf8(isolate, "exports").ToLocalChecked(), exports.ToLocalChecked());
 }
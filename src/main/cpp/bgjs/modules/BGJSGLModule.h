@@ -20,8 +20,13 @@ public:
 	static void js_canvas_constructor(const v8::FunctionCallbackInfo<v8::Value>& args);
 	static void js_canvas_getContext(const v8::FunctionCallbackInfo<v8::Value>& args);
 
-	static v8::Persistent<v8::Function> g_classRefCanvasGL;
-	static v8::Persistent<v8::Function> g_classRefContext2dGL;
+private:
+	// constructors are stored per context (and thereby per engine) in privates of the context global
+	static v8::Local<v8::Private> getClassRefKey(v8::Isolate* isolate, const char* name);
+	static v8::MaybeLocal<v8::Function> getClassRef(v8::Local<v8::Context> context, const char* name);
+
+	static constexpr const char* kClassRefCanvasGL = "BGJSGLModule:CanvasGL";
+	static constexpr const char* kClassRefContext2dGL = "BGJSGLModule:Context2dGL";
 };
 
 
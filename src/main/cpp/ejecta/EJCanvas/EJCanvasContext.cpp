@@ -40,6 +40,7 @@ EJCanvasContext::EJCanvasContext (short widthp, short heightp) {
 	path = new EJPath();
 	backingStoreRatio = 1;
 	_font = NULL;
+	_engine = NULL;
 
 	// TODO: Font
 	// fontCache = [[NSCache alloc] init];
@@ -162,6 +163,7 @@ void EJCanvasContext::createStencilBufferOnce () {
 #endif
 	COMPAT_glFramebufferRenderbuffer(COMPAT_GL_FRAMEBUFFER, COMPAT_GL_STENCIL_ATTACHMENT, COMPAT_GL_RENDERBUFFER, stencilBuffer);
 	checkGlError("COMPAT_glFramebufferRenderbuffer(createStencilBufferOnce)");
+	updateBufferMemory();
 
 	// COMPAT_glBindRenderbuffer(COMPAT_GL_RENDERBUFFER, msaaEnabled ? msaaRenderBuffer : viewRenderBuffer );
 
@@ -491,6 +493,7 @@ EJImageData* EJCanvasContext::getImageDataSx (float sx, float sy, float sw, floa
 
 void EJCanvasContext::putImageData (EJImageData* imageData, float dx, float dy) {
 	EJTexture * texture = imageData->getTexture();
+	texture->setEngine(_engine);
 	this->setTexture(texture);
 
 	short tw = texture->realWidth;
@@ -567,6 +570,7 @@ EJFont* EJCanvasContext::acquireFont (char* fontName, float pointSize, bool fill
 		delete(_font);
 	}
 	_font = new EJFont(fontName, pointSize, fill, contentScale);
+	_font->setEngine(_engine);
 	return _font;
 
 	// TODO: Caching
@@ -600,3 +604,21 @@ float EJCanvasContext::measureText (const char* text) {
 	/* EJFont *font = [self acquireFont:state->font.fontName size:state->font.pointSize fill:YES contentScale:backingStoreRatio];
 	return [font measureString:text]; */
 }
+
+void EJCanvasContext::setEngine (BGJSV8Engine *engine) {
+	_engine = engine;
+	_bufferMemory.setEngine(engine);
+	if( _font ) { _font->setEngine(engine); }
+}
+
+void EJCanvasContext::updateBufferMemory() {
+	const size_t pixels = (size_t)bufferWidth * bufferHeight;
+	const size_t samples = msaaEnabled ? msaaSamples : 1;
+	size_t size = 0;
+
+	// the view framebuffer belongs to the window surface; only buffers allocated by the context are counted
+	if( msaaRenderBuffer ) { size += pixels * 4 * samples; }
+	if( stencilBuffer ) { size += pixels * samples; }
+
+	_bufferMemory.setSize((int64_t)size);
+}
@@ -102,6 +102,11 @@ protected:
 	EJPath *path;
 	EJFont *_font;
 
+	// memory of the offscreen buffers; textures report their own memory
+	BGJSV8Engine *_engine;
+	BGJSExternalMemory _bufferMemory{BGJSExternalMemoryType::kGPU};
+	void updateBufferMemory();
+
 	int vertexBufferIndex;
 
 	int stateIndex;
@@ -158,6 +163,9 @@ public:
 	void strokeText (const char* text, float x, float y);
 	float measureText (const char* text);
 
+	// reports the memory of buffers and textures allocated by this context to the specified engine
+	void setEngine (BGJSV8Engine *engine);
+
 	// Synthesized
 	void setGlobalCompositeOperation (EJCompositeOperation op);
 	EJCompositeOperation globalCompositeOperation();
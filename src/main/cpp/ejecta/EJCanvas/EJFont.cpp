@@ -25,6 +25,7 @@ EJFont::EJFont(const char* font, int size, bool useFill, float cs) {
     isFilled = useFill;
     _textureInitialized = false;
     _texture = NULL;  // Don't create texture yet - wait for OpenGL context
+    _engine = NULL;
 
     // Select appropriate font
     _font = &font_basier_medium_24;
@@ -100,6 +101,7 @@ void EJFont::ensureTextureInitialized() {
         LOGE("EJTexture::initWithWidth returned NULL!");
         return;
     }
+    _texture->setEngine(_engine);
 
     if (_texture->textureId == 0) {
         LOGE("Texture created but textureId is 0!");
@@ -135,6 +137,7 @@ void EJFont::ensureTextureInitialized() {
 
         // Override the texture ID
         _texture->textureId = texId;
+        _texture->updateExternalMemory();
     }
 
     // Bind and set parameters
@@ -300,4 +303,11 @@ float EJFont::measureStringFromBuffer(int length) {
     }
 
     return width;
-}
\ No newline at end of file
+}
+
+void EJFont::setEngine(BGJSV8Engine* engine) {
+    _engine = engine;
+    if (_texture) {
+        _texture->setEngine(engine);
+    }
+}
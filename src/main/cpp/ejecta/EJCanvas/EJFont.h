@@ -48,6 +48,7 @@ private:
     size_t utf32bufsize;
     EJTexture* _texture;
     bool _textureInitialized;
+    BGJSV8Engine* _engine;
 
     void ensureTextureInitialized();
     float measureStringFromBuffer(int length);
@@ -58,6 +59,8 @@ public:
 
     void drawString(const char* utf8string, EJCanvasContext* toContext, float pen_x, float pen_y);
     float measureString(const char* utf8string);
+    // reports the memory of the glyph texture to the specified engine
+    void setEngine(BGJSV8Engine* engine);
 };
 
 #endif
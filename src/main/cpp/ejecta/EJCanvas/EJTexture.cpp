@@ -154,6 +154,8 @@ void EJTexture::createTextureWithPixels (GLubyte *pixels, GLenum formatp) {
 
 	glBindTexture(GL_TEXTURE_2D, boundTexture);
 	if( !wasEnabled ) {	glDisable(GL_TEXTURE_2D); }
+
+	updateExternalMemory();
 }
 
 void EJTexture::updateTextureWithPixels (GLubyte *pixels, int x, int y, int subWidth, int subHeight) {
@@ -218,3 +220,25 @@ GLubyte *EJTexture::loadPixelsWithLodePNGFromPath (const char* path) {
 void EJTexture::bind() {
 	glBindTexture(GL_TEXTURE_2D, textureId);
 }
+
+size_t EJTexture::getByteSize() const {
+	if( !textureId ) { return 0; }
+
+	size_t bytesPerPixel;
+	switch( format ) {
+		case GL_ALPHA:
+		case GL_LUMINANCE: bytesPerPixel = 1; break;
+		case GL_LUMINANCE_ALPHA: bytesPerPixel = 2; break;
+		case GL_RGB: bytesPerPixel = 3; break;
+		default: bytesPerPixel = 4; break;
+	}
+	return (size_t)realWidth * realHeight * bytesPerPixel;
+}
+
+void EJTexture::setEngine (BGJSV8Engine *engine) {
+	_gpuMemory.setEngine(engine);
+}
+
+void EJTexture::updateExternalMemory() {
+	_gpuMemory.setSize((int64_t)getByteSize());
+}
@@ -2,6 +2,7 @@
 #define __EJTEXTURE_H	1
 
 #include "GLcompat.h"
+#include "../../bgjs/BGJSExternalMemory.h"
 
 
 using namespace std;
@@ -27,6 +28,11 @@ public:
 
 	GLubyte *loadPixelsFromPath (const char* path);
 	void bind();
+	size_t getByteSize() const;
+
+	// reports the texture memory to the specified engine
+	void setEngine (BGJSV8Engine *engine);
+	void updateExternalMemory();
 
 	static void setSmoothScaling(bool smoothScaling);
 	static bool smoothScaling();
@@ -34,6 +40,7 @@ public:
 private:
 	const char* fullPath;
 	GLenum format;
+	BGJSExternalMemory _gpuMemory{BGJSExternalMemoryType::kGPU};
 	GLubyte *loadPixelsWithLodePNGFromPath (const char* path);
 };
 
@@ -23,6 +23,10 @@ const std::string& JNIBase::getCanonicalName() const {
     return _jniClassInfo->canonicalName;
 }
 
+size_t JNIBase::getClassId() const {
+    return _jniClassInfo->classId;
+}
+
 const jclass JNIBase::getJClass() const {
     return _jniClassInfo->jniClassRef;
 }
@@ -29,6 +29,7 @@ public:
     }
 
     const std::string& getCanonicalName() const;
+    size_t getClassId() const;
     const jclass getJClass() const;
     const std::string getSignature() const;
 
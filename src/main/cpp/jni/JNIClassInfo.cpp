@@ -9,8 +9,17 @@
 #include "JNIWrapper.h"
 #include "JNIClassInfo.h"
 
-JNIClassInfo::JNIClassInfo(size_t hashCode, JNIObjectType  type, jclass clazz, const std::string& canonicalName, ObjectInitializer i, ObjectConstructor c, JNIClassInfo *baseClassInfo) :
-        hashCode(hashCode), type(type), canonicalName(canonicalName), initializer(i), constructor(c), baseClassInfo(baseClassInfo) {
+JNIClassInfo::JNIClassInfo(size_t classId, size_t hashCode, JNIObjectType  type, jclass clazz, const std::string& canonicalName, ObjectInitializer i, ObjectConstructor c, JNIClassInfo *baseClassInfo) :
+        classId(classId), hashCode(hashCode), type(type), canonicalName(canonicalName), initializer(i), constructor(c), baseClassInfo(baseClassInfo) {
+    // instance-of checks only test a single bit
+    if(baseClassInfo) {
+        ancestorBits = baseClassInfo->ancestorBits;
+    }
+    if(ancestorBits.size() <= (classId >> 6)) {
+        ancestorBits.resize((classId >> 6) + 1, 0);
+    }
+    ancestorBits[classId >> 6] |= (uint64_t)1 << (classId & 63);
+
     // cache class
     // if we wanted to allow dynamic class unloading we could use a weak global ref and check it every time before creating/wrapping an object
     // but because that might happen from another thread we would have to make sure to use the correct class loader to require it..
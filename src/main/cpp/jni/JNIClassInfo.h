@@ -8,6 +8,7 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <cstdint>
 
 class JNIClassInfo;
 class JNIObject;
@@ -101,8 +102,28 @@ public:
     void registerField(const std::string& fieldName, const std::string& signature, const std::string& alias = "");
     void registerStaticField(const std::string& fieldName, const std::string& signature, const std::string& alias = "");
 
+    /**
+     * id of classes that are not registered (yet)
+     */
+    static constexpr size_t kInvalidClassId = (size_t)-1;
+
+    /**
+     * dense id assigned to the class at registration time
+     */
+    size_t getClassId() const {
+        return classId;
+    }
+
+    /**
+     * checks if this class is the class with the specified id or one of its subclasses
+     */
+    bool isSubclassOf(size_t ancestorId) const {
+        size_t word = ancestorId >> 6;
+        return word < ancestorBits.size() && ((ancestorBits[word] >> (ancestorId & 63)) & 1);
+    }
+
 private:
-    JNIClassInfo(size_t hashCode, JNIObjectType type, jclass clazz, const std::string& canonicalName, ObjectInitializer i, ObjectConstructor c, JNIClassInfo *baseClassInfo);
+    JNIClassInfo(size_t classId, size_t hashCode, JNIObjectType type, jclass clazz, const std::string& canonicalName, ObjectInitializer i, ObjectConstructor c, JNIClassInfo *baseClassInfo);
     void inherit();
 
     jmethodID getMethodID(const std::string& methodName,
@@ -120,7 +141,10 @@ private:
     std::vector<JNINativeMethod> methods;
     jclass jniClassRef;
     std::string canonicalName;
+    size_t classId;
     size_t hashCode;
+    // bitset of the ids of this class and all its base classes
+    std::vector<uint64_t> ancestorBits;
     std::map<std::string, JNIMethodInfo> methodMap;
     std::map<std::string, JNIFieldInfo> fieldMap;
 };
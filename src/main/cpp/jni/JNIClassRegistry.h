@@ -0,0 +1,92 @@
+//
+// Created on 19.10.26.
+//
+
+#ifndef __JNICLASSREGISTRY_H
+#define __JNICLASSREGISTRY_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * Append-only table of class infos indexed by class id
+ *
+ * Lookups do not take a lock and can run concurrently with registrations; registrations have to be serialized by
+ * the caller. Entries are stored in place while there is capacity left. When the table is full, the entries are
+ * copied to a new table with twice the capacity, which is then published. Replaced tables can still be in use by
+ * readers on other threads, so they are only freed when the registry is destroyed; because the capacity doubles,
+ * they never take more memory than the current table.
+ */
+template <class T>
+class JNIClassRegistry {
+public:
+    JNIClassRegistry() : _table(nullptr), _size(0) {}
+
+    ~JNIClassRegistry() {
+        delete _table.load(std::memory_order_relaxed);
+        for (auto *table : _retiredTables) {
+            delete table;
+        }
+    }
+
+    JNIClassRegistry(const JNIClassRegistry&) = delete;
+    JNIClassRegistry& operator=(const JNIClassRegistry&) = delete;
+
+    /**
+     * returns the entry for the specified id, or nullptr if there is none
+     */
+    T* get(size_t id) const {
+        const Table *table = _table.load(std::memory_order_acquire);
+        return table && id < table->capacity ? table->entries[id].load(std::memory_order_acquire) : nullptr;
+    }
+
+    /**
+     * returns one more than the highest id that has been set
+     */
+    size_t size() const {
+        return _size.load(std::memory_order_acquire);
+    }
+
+    /**
+     * stores the entry for the specified id
+     * NOTE: calls have to be serialized
+     */
+    void set(size_t id, T *entry) {
+        Table *table = _table.load(std::memory_order_relaxed);
+        if (!table || id >= table->capacity) {
+            size_t capacity = table ? table->capacity : kInitialCapacity;
+            while (capacity <= id) {
+                capacity *= 2;
+            }
+            auto *grownTable = new Table(capacity);
+            if (table) {
+                for (size_t i = 0; i < table->capacity; i++) {
+                    grownTable->entries[i].store(table->entries[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+                }
+                _retiredTables.push_back(table);
+            }
+            _table.store(grownTable, std::memory_order_release);
+            table = grownTable;
+        }
+        table->entries[id].store(entry, std::memory_order_release);
+        if (id >= _size.load(std::memory_order_relaxed)) {
+            _size.store(id + 1, std::memory_order_release);
+        }
+    }
+
+private:
+    static const size_t kInitialCapacity = 64;
+
+    struct Table {
+        explicit Table(size_t capacity) : capacity(capacity), entries(new std::atomic<T*>[capacity]()) {}
+        const size_t capacity;
+        std::unique_ptr<std::atomic<T*>[]> entries;
+    };
+
+    std::atomic<Table*> _table;
+    std::atomic<size_t> _size;
+    std::vector<Table*> _retiredTables;
+};
+
+#endif
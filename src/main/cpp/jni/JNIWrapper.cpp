@@ -5,6 +5,7 @@
 #include "stdlib.h"
 #include <jni.h>
 #include <cstdlib>
+#include <cstring>
 #include "JNIWrapper.h"
 
 pthread_key_t JNIWrapper::_jniEnvKey = NULL;
@@ -19,15 +20,8 @@ void JNIWrapper::init(JavaVM *vm) {
 
     pthread_key_create(&_jniEnvKey, NULL);
     pthread_key_create(&_jniDetachThreadKey, &detachThread);
-    JNIEnv *env = JNIWrapper::getEnvironment();
-
-    _jniStringClass = (jclass)env->NewGlobalRef(env->FindClass("java/lang/String"));
-    _jniStringInit = env->GetMethodID(_jniStringClass, "<init>", "([BLjava/lang/String;)V");
-    _jniStringGetBytes = env->GetMethodID(_jniStringClass, "getBytes",
-                                          "(Ljava/lang/String;)[B");
-    _jniCharsetName = (jstring)env->NewGlobalRef(env->NewStringUTF("UTF-8"));
 
-    _registerObject(typeid(JNIObject).hash_code(), JNIObjectType::kAbstract,
+    _classId<JNIObject> = _registerObject(typeid(JNIObject).hash_code(), JNIObjectType::kAbstract,
                     JNIBase::getCanonicalName<JNIObject>(), "", initialize<JNIObject>, nullptr);
 }
 
@@ -36,26 +30,33 @@ bool JNIWrapper::isInitialized() {
 }
 
 bool JNIWrapper::isObjectInstanceOf(JNIObject *obj, const std::string &canonicalName) {
+    const size_t classId = getClassId(canonicalName);
+    return classId != JNIClassInfo::kInvalidClassId && obj->_jniClassInfo->isSubclassOf(classId);
+}
+
+size_t JNIWrapper::getClassId(const std::string &canonicalName) {
+    std::lock_guard<std::recursive_mutex> guard(_registryMutex);
     auto it = _objmap.find(canonicalName);
-    if(it == _objmap.end()) return false;
-    JNIClassInfo *info = it->second;
-    JNIClassInfo *info2 = obj->_jniClassInfo;
-    while(info2 != info) {
-        info2 = info2->baseClassInfo;
-        if(!info2) {
-            return false;
-        }
-    }
-    return true;
+    if(it == _objmap.end()) return JNIClassInfo::kInvalidClassId;
+    return it->second->classId;
+}
+
+JNIClassInfo* JNIWrapper::_getClassInfo(size_t classId) {
+    return _classInfos.get(classId);
 }
 
-void JNIWrapper::_registerObject(size_t hashCode, JNIObjectType type,
+size_t JNIWrapper::_registerObject(size_t hashCode, JNIObjectType type,
                                  const std::string &canonicalName, const std::string &baseCanonicalName,
                                  ObjectInitializer i, ObjectConstructor c) {
+    // classes can be registered from any thread (e.g. via JNIV8Object.RegisterV8Class) while others wrap objects
+    // registration itself is serialized; it is recursive, because initializers might look up other classes
+    std::lock_guard<std::recursive_mutex> guard(_registryMutex);
+
     // canonicalName may be already registered
     // (e.g. when called from JNI_OnLoad; when using multiple linked libraries it is called once for each library)
-    if(_objmap.find(canonicalName) != _objmap.end()) {
-        return;
+    auto existing = _objmap.find(canonicalName);
+    if(existing != _objmap.end()) {
+        return existing->second->classId;
     }
 
     JNI_ASSERT(baseCanonicalName != "<unknown>" && canonicalName != "<unknown>", "Could not resolve canonicalnames; missing BGJS_JNI_LINK_DEF?");
@@ -68,19 +69,19 @@ void JNIWrapper::_registerObject(size_t hashCode, JNIObjectType type,
         it = _objmap.find(baseCanonicalName);
         if (it == _objmap.end()) {
             JNI_ASSERT(0, "Attempt to register objects with unknown super class");
-            return;
+            return JNIClassInfo::kInvalidClassId;
         }
         baseInfo = it->second;
 
         // pure java objects can not directly extend JNIObject
         if(JNIBase::getCanonicalName<JNIObject>() == baseCanonicalName && !i) {
             JNI_ASSERT(0, "Pure java objects must not directly extend JNIObject");
-            return;
+            return JNIClassInfo::kInvalidClassId;
         }
     } else if(canonicalName != JNIBase::getCanonicalName<JNIObject>()) {
         // an empty base class is only allowed here for internally registering JNIObject itself
         JNI_ASSERT(0, "Attempt to register an object without super class");
-        return;
+        return JNIClassInfo::kInvalidClassId;
     }
 
     if(baseInfo) {
@@ -90,7 +91,7 @@ void JNIWrapper::_registerObject(size_t hashCode, JNIObjectType type,
             do {
                 if (baseInfo2->type != JNIObjectType::kTemporary && baseInfo2->baseClassInfo) {
                     JNI_ASSERT(0, "Temporary classes can only extend JNIObject or other temporary classes");
-                    return;
+                    return JNIClassInfo::kInvalidClassId;
                 }
                 baseInfo2 = baseInfo->baseClassInfo;
             } while (baseInfo2);
@@ -98,7 +99,7 @@ void JNIWrapper::_registerObject(size_t hashCode, JNIObjectType type,
                    baseInfo->type != type) {
             // temporary classes can only be extended by other temporary classes!
             JNI_ASSERT(0, "Temporary classes can only be extended by other temporary classes");
-            return;
+            return JNIClassInfo::kInvalidClassId;
         }
     }
 
@@ -110,7 +111,9 @@ void JNIWrapper::_registerObject(size_t hashCode, JNIObjectType type,
     // class has to exist...
     JNI_ASSERTF(clazz != nullptr, "Class '%s' not found", canonicalName.c_str());
 
-    auto *info = new JNIClassInfo(hashCode, type, clazz, canonicalName, i, c, baseInfo);
+    // ids are dense, so all registries can be flat vectors indexed by id
+    auto *info = new JNIClassInfo(_classInfos.size(), hashCode, type, clazz, canonicalName, i, c, baseInfo);
+    _classInfos.set(info->classId, info);
     _objmap[canonicalName] = info;
 
     info->inherit();
@@ -143,6 +146,8 @@ void JNIWrapper::_registerObject(size_t hashCode, JNIObjectType type,
             info->methods.clear();
         }
     }
+
+    return info->classId;
 }
 
 JNIEnv* JNIWrapper::getEnvironment() {
@@ -165,21 +170,18 @@ void JNIWrapper::initializeNativeObject(jobject object, jstring className) {
     std::replace(canonicalName.begin(), canonicalName.end(), '.', '/');
 
     // now retrieve registered native class
-    auto it = _objmap.find(canonicalName);
+    JNIClassInfo *info = _getClassInfo(getClassId(canonicalName));
 
     // if nothing was found, the class was not registered
-    JNI_ASSERTF(it != _objmap.end(), "Encountered unknown class '%s' during initialization", canonicalName.c_str());
+    JNI_ASSERTF(info != nullptr, "Encountered unknown class '%s' during initialization", canonicalName.c_str());
 
-    JNIClassInfo *info = it->second;
     info->constructor(object, info);
 }
 
-jobject JNIWrapper::_createObject(const std::string& canonicalName, const char* constructorAlias, va_list constructorArgs) {
-    auto it = _objmap.find(canonicalName);
-    if (it == _objmap.end()) {
+jobject JNIWrapper::_createObject(JNIClassInfo *info, const char* constructorAlias, va_list constructorArgs) {
+    if (!info) {
         return nullptr;
     } else {
-        JNIClassInfo *info = it->second;
 
         if(info->type == JNIObjectType::kAbstract) return nullptr;
 
@@ -196,16 +198,146 @@ jobject JNIWrapper::_createObject(const std::string& canonicalName, const char*
     }
 }
 
-std::shared_ptr<JNIClass> JNIWrapper::_wrapClass(const std::string& canonicalName) {
-    auto it = _objmap.find(canonicalName);
-    if (it == _objmap.end()){
+std::shared_ptr<JNIClass> JNIWrapper::_wrapClass(JNIClassInfo *info) {
+    if (!info){
         return nullptr;
     } else {
-        JNIClassInfo *info = it->second;
         return std::shared_ptr<JNIClass>(new JNIClass(info));
     }
 }
 
+// strings up to this length are transcoded using a buffer on the stack
+static const size_t kStackBufferLength = 256;
+
+/**
+ * returns the number of leading ascii characters in chars
+ * four UTF-16 units are checked at once
+ */
+static size_t countAsciiChars(const jchar *chars, size_t length) {
+    size_t i = 0;
+    for (; i + 4 <= length; i += 4) {
+        uint64_t block;
+        memcpy(&block, chars + i, sizeof(block));
+        if (block & 0xFF80FF80FF80FF80ULL) break;
+    }
+    while (i < length && chars[i] < 0x80) i++;
+    return i;
+}
+
+/**
+ * returns the number of leading ascii bytes in bytes
+ * eight bytes are checked at once
+ */
+static size_t countAsciiBytes(const uint8_t *bytes, size_t length) {
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t block;
+        memcpy(&block, bytes + i, sizeof(block));
+        if (block & 0x8080808080808080ULL) break;
+    }
+    while (i < length && bytes[i] < 0x80) i++;
+    return i;
+}
+
+/**
+ * encodes UTF-16 as UTF-8; target must have room for 3 bytes per char
+ * unpaired surrogates are replaced with '?' (like String.getBytes does)
+ * returns the number of bytes written
+ */
+static size_t encodeUtf8(const jchar *chars, size_t length, char *target) {
+    char *out = target;
+    size_t i = 0;
+    while (i < length) {
+        // ascii fast path
+        size_t ascii = countAsciiChars(chars + i, length - i);
+        for (size_t end = i + ascii; i < end; i++) {
+            *out++ = (char)chars[i];
+        }
+        if (i >= length) break;
+
+        uint32_t c = chars[i++];
+        if (c < 0x800) {
+            *out++ = (char)(0xC0 | (c >> 6));
+            *out++ = (char)(0x80 | (c & 0x3F));
+        } else if (c < 0xD800 || c > 0xDFFF) {
+            *out++ = (char)(0xE0 | (c >> 12));
+            *out++ = (char)(0x80 | ((c >> 6) & 0x3F));
+            *out++ = (char)(0x80 | (c & 0x3F));
+        } else if (c <= 0xDBFF && i < length && chars[i] >= 0xDC00 && chars[i] <= 0xDFFF) {
+            c = 0x10000 + ((c - 0xD800) << 10) + (chars[i++] - 0xDC00);
+            *out++ = (char)(0xF0 | (c >> 18));
+            *out++ = (char)(0x80 | ((c >> 12) & 0x3F));
+            *out++ = (char)(0x80 | ((c >> 6) & 0x3F));
+            *out++ = (char)(0x80 | (c & 0x3F));
+        } else {
+            *out++ = '?';
+        }
+    }
+    return out - target;
+}
+
+/**
+ * decodes UTF-8 to UTF-16; target must have room for one char per byte
+ * malformed sequences are replaced with U+FFFD (like new String(bytes, "UTF-8") does)
+ * returns the number of chars written
+ */
+static size_t decodeUtf8(const uint8_t *bytes, size_t length, jchar *target) {
+    jchar *out = target;
+    size_t i = 0;
+    while (i < length) {
+        // ascii fast path
+        size_t ascii = countAsciiBytes(bytes + i, length - i);
+        for (size_t end = i + ascii; i < end; i++) {
+            *out++ = bytes[i];
+        }
+        if (i >= length) break;
+
+        // the valid range of the second byte excludes overlong forms, surrogates and values above U+10FFFF
+        uint8_t b = bytes[i];
+        size_t numContinuation;
+        uint32_t c;
+        uint8_t lower = 0x80, upper = 0xBF;
+        if (b >= 0xC2 && b <= 0xDF) {
+            numContinuation = 1; c = b & 0x1F;
+        } else if (b >= 0xE0 && b <= 0xEF) {
+            numContinuation = 2; c = b & 0x0F;
+            if (b == 0xE0) lower = 0xA0;
+            if (b == 0xED) upper = 0x9F;
+        } else if (b >= 0xF0 && b <= 0xF4) {
+            numContinuation = 3; c = b & 0x07;
+            if (b == 0xF0) lower = 0x90;
+            if (b == 0xF4) upper = 0x8F;
+        } else {
+            *out++ = 0xFFFD;
+            i++;
+            continue;
+        }
+
+        size_t j = 1;
+        for (; j <= numContinuation && i + j < length; j++) {
+            uint8_t next = bytes[i + j];
+            if (next < lower || next > upper) break;
+            c = (c << 6) | (next & 0x3F);
+            lower = 0x80; upper = 0xBF;
+        }
+        i += j;
+        if (j <= numContinuation) {
+            // truncated or invalid sequence; replaced as a whole
+            *out++ = 0xFFFD;
+            continue;
+        }
+
+        if (c >= 0x10000) {
+            c -= 0x10000;
+            *out++ = (jchar)(0xD800 + (c >> 10));
+            *out++ = (jchar)(0xDC00 + (c & 0x3FF));
+        } else {
+            *out++ = (jchar)c;
+        }
+    }
+    return out - target;
+}
+
 /**
  * convert a jstring to a std::string
  */
@@ -218,15 +350,17 @@ std::string JNIWrapper::jstring2string(jstring string) {
         return "";
     }
 
-    const auto stringJbytes = (jbyteArray) env->CallObjectMethod(string, _jniStringGetBytes, _jniCharsetName);
-    const jsize length = env->GetArrayLength(stringJbytes);
-    jbyte* pBytes = env->GetByteArrayElements(stringJbytes, nullptr);
-
-    std::string ret = std::string((char *)pBytes, (unsigned long)length);
-
-    env->ReleaseByteArrayElements(stringJbytes, pBytes, JNI_ABORT);
-    env->DeleteLocalRef(stringJbytes);
+    // transcode directly from the java string; no other JNI functions may be called while the chars are held
+    const auto length = (size_t)env->GetStringLength(string);
+    std::string ret(length * 3, '\0');
+    const jchar *chars = env->GetStringCritical(string, nullptr);
+    if (!chars) {
+        return "";
+    }
+    size_t utf8Length = encodeUtf8(chars, length, &ret[0]);
+    env->ReleaseStringCritical(string, chars);
 
+    ret.resize(utf8Length);
     return ret;
 }
 
@@ -237,22 +371,26 @@ jstring JNIWrapper::string2jstring(const std::string& string) {
     JNIEnv *env = JNIWrapper::getEnvironment();
     JNI_ASSERT(env, "JNI Environment not initialized");
 
-    auto len = (jsize)string.length();
-
-    const jbyteArray bytes = env->NewByteArray(len);
-    env->SetByteArrayRegion(bytes, 0, len, (jbyte*)string.c_str());
+    const size_t length = string.length();
+    jchar stackBuffer[kStackBufferLength];
+    jchar *chars = length <= kStackBufferLength ? stackBuffer : (jchar*)malloc(length * sizeof(jchar));
+    if (!chars) {
+        env->ThrowNew(env->FindClass("java/lang/OutOfMemoryError"), "Failed to allocate string buffer");
+        return nullptr;
+    }
 
-    auto javaString = (jstring)env->NewObject(_jniStringClass, _jniStringInit, bytes, _jniCharsetName);
+    size_t utf16Length = decodeUtf8((const uint8_t*)string.data(), length, chars);
+    auto javaString = env->NewString(chars, (jsize)utf16Length);
 
-    env->DeleteLocalRef(bytes);
+    if (chars != stackBuffer) {
+        free(chars);
+    }
 
     return javaString;
 }
 
+JNIClassRegistry<JNIClassInfo> JNIWrapper::_classInfos;
 std::map<std::string, JNIClassInfo*> JNIWrapper::_objmap;
+std::recursive_mutex JNIWrapper::_registryMutex;
 jfieldID JNIWrapper::_jniNativeHandleFieldID = nullptr;
 JavaVM* JNIWrapper::_jniVM = nullptr;
-jstring JNIWrapper::_jniCharsetName = nullptr;
-jclass JNIWrapper::_jniStringClass = nullptr;
-jmethodID JNIWrapper::_jniStringInit = nullptr;
-jmethodID JNIWrapper::_jniStringGetBytes = nullptr;
\ No newline at end of file
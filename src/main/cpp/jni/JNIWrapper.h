@@ -8,12 +8,14 @@
 #import <vector>
 #import <string>
 #import <map>
+#include <mutex>
 #include <jni.h>
 #include "jni_assert.h"
 #include <unistd.h>
 #include <pthread.h>
 
 #include "JNIRef.h"
+#include "JNIClassRegistry.h"
 #include "JNIClassInfo.h"
 #include "JNIClass.h"
 #include "JNIObject.h"
@@ -29,9 +31,19 @@ public:
      */
     static bool isObjectInstanceOf(JNIObject *obj, const std::string &canonicalName);
     template<class ObjectType> static bool isObjectInstanceOf(JNIObject *obj) {
-        return isObjectInstanceOf(obj, JNIBase::getCanonicalName<ObjectType>());
+        const size_t classId = _classId<ObjectType>;
+        return classId != JNIClassInfo::kInvalidClassId && obj->_jniClassInfo->isSubclassOf(classId);
     }
 
+    /**
+     * returns the dense id assigned to the specified native object type at registration time
+     * or JNIClassInfo::kInvalidClassId if the type was not registered
+     */
+    template<class ObjectType> static size_t getClassId() {
+        return _classId<ObjectType>;
+    }
+    static size_t getClassId(const std::string &canonicalName);
+
     /**
      * returns the java signature of the specified native object type
      */
@@ -47,7 +59,7 @@ public:
      */
     template<class ObjectType> static
     void registerObject(JNIObjectType type = JNIObjectType::kPersistent) {
-        _registerObject(typeid(ObjectType).hash_code(), type, JNIBase::getCanonicalName<ObjectType>(), JNIBase::getCanonicalName<JNIObject>(),
+        _classId<ObjectType> = _registerObject(typeid(ObjectType).hash_code(), type, JNIBase::getCanonicalName<ObjectType>(), JNIBase::getCanonicalName<JNIObject>(),
                         initialize<ObjectType>, type != JNIObjectType::kTemporary ? instantiate<ObjectType> : nullptr);
     };
 
@@ -59,7 +71,7 @@ public:
      */
     template<class ObjectType, class BaseObjectType> static
     void registerObject(JNIObjectType type = JNIObjectType::kPersistent) {
-        _registerObject(typeid(ObjectType).hash_code(), type, JNIBase::getCanonicalName<ObjectType>(), JNIBase::getCanonicalName<BaseObjectType>(),
+        _classId<ObjectType> = _registerObject(typeid(ObjectType).hash_code(), type, JNIBase::getCanonicalName<ObjectType>(), JNIBase::getCanonicalName<BaseObjectType>(),
                         initialize<ObjectType>, type != JNIObjectType::kTemporary ? instantiate<ObjectType> : nullptr);
     };
 
@@ -91,7 +103,7 @@ public:
     JNIRetainedRef<ObjectType> createObject(const char *constructorAlias = nullptr, ...) {
         va_list args;
         va_start(args, constructorAlias);
-        jobject obj = _createObject(JNIBase::getCanonicalName<ObjectType>(), constructorAlias, args);
+        jobject obj = _createObject(_getClassInfo(_classId<ObjectType>), constructorAlias, args);
         va_end(args);
         JNIRetainedRef<ObjectType> ptr = JNIRetainedRef<ObjectType>::New(JNIWrapper::wrapObject<ObjectType>(obj));
         JNIWrapper::getEnvironment()->DeleteLocalRef(obj);
@@ -100,7 +112,7 @@ public:
 
     template <typename ObjectType> static
     JNIRetainedRef<ObjectType> createObject(const char *constructorAlias, va_list args) {
-        jobject obj = _createObject(JNIBase::getCanonicalName<ObjectType>(), constructorAlias, args);
+        jobject obj = _createObject(_getClassInfo(_classId<ObjectType>), constructorAlias, args);
         JNIRetainedRef<ObjectType> ptr = JNIRetainedRef<ObjectType>::New(JNIWrapper::wrapObject<ObjectType>(obj));
         JNIWrapper::getEnvironment()->DeleteLocalRef(obj);
         return ptr;
@@ -119,7 +131,7 @@ public:
     JNIRetainedRef<ObjectType> createDerivedObject(const std::string &canonicalName, const char *constructorAlias = nullptr, ...) {
         va_list args;
         va_start(args, constructorAlias);
-        jobject obj = _createObject(canonicalName, constructorAlias, args);
+        jobject obj = _createObject(_getClassInfo(getClassId(canonicalName)), constructorAlias, args);
         va_end(args);
         JNIRetainedRef<ObjectType> ptr = JNIRetainedRef<ObjectType>::New(JNIWrapper::wrapObject<ObjectType>(obj));
         JNIWrapper::getEnvironment()->DeleteLocalRef(obj);
@@ -128,7 +140,7 @@ public:
 
     template <typename ObjectType> static
     JNIRetainedRef<ObjectType> createDerivedObject(const std::string &canonicalName, const char *constructorAlias, va_list args) {
-        jobject obj = _createObject(canonicalName, constructorAlias, args);
+        jobject obj = _createObject(_getClassInfo(getClassId(canonicalName)), constructorAlias, args);
         JNIRetainedRef<ObjectType> ptr = JNIRetainedRef<ObjectType>::New(JNIWrapper::wrapObject<ObjectType>(obj));
         JNIWrapper::getEnvironment()->DeleteLocalRef(obj);
         return ptr;
@@ -140,11 +152,11 @@ public:
      */
     template <typename ObjectType> static
     JNILocalRef<ObjectType> wrapObject(jobject object) {
-        auto it = _objmap.find(JNIBase::getCanonicalName<ObjectType>());
-        if (!object || it == _objmap.end()){
+        const size_t classId = _classId<ObjectType>;
+        if (!object || classId == JNIClassInfo::kInvalidClassId){
             return nullptr;
         } else {
-            JNIClassInfo *info = it->second;
+            JNIClassInfo *info = _classInfos.get(classId);
             JNIObject *jniObject;
             JNIEnv* env = JNIWrapper::getEnvironment();
             if(info->type == JNIObjectType::kPersistent || info->type == JNIObjectType::kAbstract) {
@@ -160,12 +172,8 @@ public:
                 }
                 jniObject = reinterpret_cast<JNIObject*>(handle);
                 // now check if this object is an instance of `ObjectType`
-                JNIClassInfo *info2 = jniObject->_jniClassInfo;
-                while(info2 != info) {
-                    info2 = info2->baseClassInfo;
-                    if(!info2) {
-                        return nullptr;
-                    }
+                if(!jniObject->_jniClassInfo->isSubclassOf(classId)) {
+                    return nullptr;
                 }
             } else {
                 jniObject = new ObjectType(object, info);
@@ -181,7 +189,7 @@ public:
      */
     template <typename ObjectType> static
     std::shared_ptr<JNIClass> wrapClass() {
-        return _wrapClass(JNIBase::getCanonicalName<ObjectType>());
+        return _wrapClass(_getClassInfo(_classId<ObjectType>));
     }
 
 
@@ -204,21 +212,25 @@ public:
 private:
     static void detachThread(void* _);
     // Factory method for creating objects
-    static jobject _createObject(const std::string& canonicalName, const char* constructorAlias, va_list constructorArgs);
-    static std::shared_ptr<JNIClass> _wrapClass(const std::string& canonicalName);
+    static jobject _createObject(JNIClassInfo *info, const char* constructorAlias, va_list constructorArgs);
+    static std::shared_ptr<JNIClass> _wrapClass(JNIClassInfo *info);
+    static JNIClassInfo* _getClassInfo(size_t classId);
 
-    static void _registerObject(size_t hashCode, JNIObjectType type, const std::string& canonicalName, const std::string& baseCanonicalName, ObjectInitializer i, ObjectConstructor c);
+    static size_t _registerObject(size_t hashCode, JNIObjectType type, const std::string& canonicalName, const std::string& baseCanonicalName, ObjectInitializer i, ObjectConstructor c);
 
     static JavaVM *_jniVM;
     static pthread_key_t _jniEnvKey, _jniDetachThreadKey;
     static jfieldID _jniNativeHandleFieldID;
 
-    static jclass _jniStringClass;
-    static jmethodID _jniStringGetBytes;
-    static jmethodID _jniStringInit;
-    static jstring _jniCharsetName;
-
+    // registered classes indexed by class id; can be read without a lock
+    static JNIClassRegistry<JNIClassInfo> _classInfos;
+    // registered classes by name; guarded by _registryMutex, which also serializes registration
     static std::map<std::string, JNIClassInfo*> _objmap;
+    static std::recursive_mutex _registryMutex;
+
+    // class id of each registered native type
+    template<class ObjectType>
+    static inline size_t _classId = JNIClassInfo::kInvalidClassId;
 
     template<class ObjectType>
     static JNIObject* instantiate(jobject obj, JNIClassInfo *info) {
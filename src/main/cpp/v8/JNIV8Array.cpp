@@ -5,6 +5,9 @@
 #include "JNIV8Array.h"
 #include "JNIV8Wrapper.h"
 #include "../bgjs/BGJSV8Engine.h"
+#include "JNIV8FieldSchema.h"
+
+#include <cmath>
 
 BGJS_JNI_LINK(JNIV8Array, "ag/boersego/bgjs/JNIV8Array");
 
@@ -29,6 +32,8 @@ void JNIV8Array::initializeJNIBindings(JNIClassInfo *info, bool isReload) {
     info->registerNativeMethod("getV8Length", "()I", (void*)JNIV8Array::jniGetV8Length);
     info->registerNativeMethod("_getV8Elements", "(IILjava/lang/Class;II)[Ljava/lang/Object;", (void*)JNIV8Array::jniGetV8ElementsInRange);
     info->registerNativeMethod("_getV8Element", "(IILjava/lang/Class;I)Ljava/lang/Object;", (void*)JNIV8Array::jniGetV8Element);
+    info->registerNativeMethod("readElementFields", "(Lag/boersego/bgjs/V8FieldSchema;[D)V", (void*)JNIV8Array::jniReadElementFields);
+    info->registerNativeMethod("writeElementFields", "(Lag/boersego/bgjs/V8FieldSchema;[D)V", (void*)JNIV8Array::jniWriteElementFields);
 }
 
 /**
@@ -202,3 +207,87 @@ jobject JNIV8Array::jniCreateWithArray(JNIEnv *env, jobject obj, jobject engineO
 
     return JNIV8Wrapper::wrapObject<JNIV8Array>(objRef)->getJObject();
 }
+
+/**
+ * reads the fields described by the schema from every element of the array
+ * values are stored consecutively (element after element) in target
+ */
+void JNIV8Array::jniReadElementFields(JNIEnv *env, jobject obj, jobject schemaObj, jdoubleArray target) {
+    JNIV8Object_PrepareJNICall(JNIV8Array, v8::Array, void());
+
+    auto schema = JNIV8FieldSchema::wrapForEngine(env, schemaObj, engine);
+    if(!schema) return;
+
+    const size_t numFields = schema->getFieldCount();
+    const uint32_t len = localRef->Length();
+    if(!target || (size_t)env->GetArrayLength(target) < numFields * len) {
+        env->ThrowNew(env->FindClass("java/lang/IndexOutOfBoundsException"),
+                      "Target array is too small for schema and array length");
+        return;
+    }
+
+    std::vector<jdouble> values(numFields * len);
+    for(uint32_t i = 0; i < len; i++) {
+        v8::Local<v8::Value> valueRef;
+        if(!localRef->Get(context, i).ToLocal(&valueRef)) {
+            engine->forwardV8ExceptionToJNI(&try_catch);
+            return;
+        }
+        if(!valueRef->IsObject()) {
+            // fields of non-object elements are reported as NaN
+            std::fill(values.begin() + i * numFields, values.begin() + (i + 1) * numFields, NAN);
+            continue;
+        }
+        if(!schema->readFields(context, valueRef.As<v8::Object>(), values.data() + i * numFields)) {
+            engine->forwardV8ExceptionToJNI(&try_catch);
+            return;
+        }
+    }
+    env->SetDoubleArrayRegion(target, 0, (jsize)values.size(), values.data());
+}
+
+/**
+ * writes the fields described by the schema to the elements of the array
+ * elements that are not objects are replaced with new records of the schema; the array grows if required
+ */
+void JNIV8Array::jniWriteElementFields(JNIEnv *env, jobject obj, jobject schemaObj, jdoubleArray source) {
+    JNIV8Object_PrepareJNICall(JNIV8Array, v8::Array, void());
+
+    auto schema = JNIV8FieldSchema::wrapForEngine(env, schemaObj, engine);
+    if(!schema) return;
+
+    const size_t numFields = schema->getFieldCount();
+    if(!source) {
+        env->ThrowNew(env->FindClass("java/lang/NullPointerException"), "source must not be null");
+        return;
+    }
+    if(!numFields) return;
+
+    const size_t numElements = (size_t)env->GetArrayLength(source) / numFields;
+    std::vector<jdouble> values(numFields * numElements);
+    env->GetDoubleArrayRegion(source, 0, (jsize)values.size(), values.data());
+
+    for(uint32_t i = 0; i < numElements; i++) {
+        v8::Local<v8::Value> valueRef;
+        if(!localRef->Get(context, i).ToLocal(&valueRef)) {
+            engine->forwardV8ExceptionToJNI(&try_catch);
+            return;
+        }
+        if(!valueRef->IsObject()) {
+            v8::Local<v8::Object> recordRef;
+            if(!schema->newRecord(context).ToLocal(&recordRef)) {
+                engine->forwardV8ExceptionToJNI(&try_catch);
+                return;
+            }
+            valueRef = recordRef;
+            if(localRef->Set(context, i, valueRef).IsNothing()) {
+                engine->forwardV8ExceptionToJNI(&try_catch);
+                return;
+            }
+        }
+        if(!schema->writeFields(context, valueRef.As<v8::Object>(), values.data() + i * numFields)) {
+            engine->forwardV8ExceptionToJNI(&try_catch);
+            return;
+        }
+    }
+}
@@ -34,6 +34,18 @@ public:
      */
     static jobject jniGetV8Element(JNIEnv *env, jobject obj, jint flags, jint type, jclass returnType, jint index);
 
+    /**
+     * reads the fields described by the schema from every element of the array
+     * values are stored consecutively (element after element) in target
+     */
+    static void jniReadElementFields(JNIEnv *env, jobject obj, jobject schema, jdoubleArray target);
+
+    /**
+     * writes the fields described by the schema to the elements of the array
+     * elements that are not objects are replaced with new objects; the array grows if required
+     */
+    static void jniWriteElementFields(JNIEnv *env, jobject obj, jobject schema, jdoubleArray source);
+
     /**
      * cache JNI class references
      */
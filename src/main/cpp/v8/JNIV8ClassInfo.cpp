@@ -92,6 +92,31 @@ void JNIV8ClassInfo::initJNICache() {
     _jniObject.clazz = (jclass)env->NewGlobalRef(env->FindClass("java/lang/Object"));
 }
 
+static void throwPropertyMarshallingError(Isolate *isolate, JNIV8MarshallingError res, JNIV8ObjectJavaAccessorHolder *cb, Local<Value> value) {
+    switch(res) {
+        default:
+        case JNIV8MarshallingError::kWrongType:
+            ThrowV8TypeError("wrong type for property '" + cb->propertyName);
+            break;
+        case JNIV8MarshallingError::kUndefined:
+            ThrowV8TypeError("property '" + cb->propertyName + "' must not be undefined");
+            break;
+        case JNIV8MarshallingError::kNotNullable:
+            ThrowV8TypeError("property '" + cb->propertyName + "' is not nullable");
+            break;
+        case JNIV8MarshallingError::kNoNaN:
+            ThrowV8TypeError("property '" + cb->propertyName + "' must not be NaN");
+            break;
+        case JNIV8MarshallingError::kVoidNotNull:
+            ThrowV8TypeError("property '" + cb->propertyName + "' can only be null or undefined");
+            break;
+        case JNIV8MarshallingError::kOutOfRange:
+            ThrowV8RangeError("assigned value '"+
+                              JNIV8Marshalling::v8string2string(value->ToString(isolate->GetCurrentContext()).ToLocalChecked())+"' is out of range for property '" + cb->propertyName + "'");
+            break;
+    }
+}
+
 void JNIV8ClassInfo::v8JavaAccessorGetterCallback(Local<Name> property, const PropertyCallbackInfo<Value> &info) {
     JNIEnv *env = JNIWrapper::getEnvironment();
     JNILocalFrame localFrame(env, 1);
@@ -155,28 +180,7 @@ void JNIV8ClassInfo::v8JavaAccessorSetterCallback(Local<Name> property, Local<Va
         JNIV8MarshallingError res;
         res = JNIV8Marshalling::convertV8ValueToJavaValue(env, value, cb->propertyType, &jval);
         if(res != JNIV8MarshallingError::kOk) {
-            switch(res) {
-                default:
-                case JNIV8MarshallingError::kWrongType:
-                    ThrowV8TypeError("wrong type for property '" + cb->propertyName);
-                    break;
-                case JNIV8MarshallingError::kUndefined:
-                    ThrowV8TypeError("property '" + cb->propertyName + "' must not be undefined");
-                    break;
-                case JNIV8MarshallingError::kNotNullable:
-                    ThrowV8TypeError("property '" + cb->propertyName + "' is not nullable");
-                    break;
-                case JNIV8MarshallingError::kNoNaN:
-                    ThrowV8TypeError("property '" + cb->propertyName + "' must not be NaN");
-                    break;
-                case JNIV8MarshallingError::kVoidNotNull:
-                    ThrowV8TypeError("property '" + cb->propertyName + "' can only be null or undefined");
-                    break;
-                case JNIV8MarshallingError::kOutOfRange:
-                    ThrowV8RangeError("assigned value '"+
-                                      JNIV8Marshalling::v8string2string(value->ToString(isolate->GetCurrentContext()).ToLocalChecked())+"' is out of range for property '" + cb->propertyName + "'");
-                    break;
-            }
+            throwPropertyMarshallingError(isolate, res, cb, value);
             return;
         }
 
@@ -194,6 +198,63 @@ void JNIV8ClassInfo::v8JavaAccessorSetterCallback(Local<Name> property, Local<Va
     }
 }
 
+void JNIV8ClassInfo::v8JavaFieldGetterCallback(Local<Name> property, const PropertyCallbackInfo<Value> &info) {
+    JNIEnv *env = JNIWrapper::getEnvironment();
+    JNILocalFrame localFrame(env, 1);
+
+    Isolate *isolate = info.GetIsolate();
+    HandleScope scope(isolate);
+
+    v8::Local<v8::External> ext;
+
+    ext = info.Data().As<v8::External>();
+    auto cb = static_cast<JNIV8ObjectJavaAccessorHolder*>(ext->Value());
+
+    jobject jobj = nullptr;
+    if (!cb->isStatic) {
+        ext = info.This()->GetInternalField(0).As<v8::External>();
+        auto *v8Object = reinterpret_cast<JNIV8Object *>(ext->Value());
+
+        jobj = v8Object->getJObject();
+    }
+
+    // field access can not throw, there is no java code involved
+    info.GetReturnValue().Set(JNIV8Marshalling::getJavaField(env, cb->propertyType, cb->javaClass, cb->javaFieldId, jobj));
+}
+
+void JNIV8ClassInfo::v8JavaFieldSetterCallback(Local<Name> property, Local<Value> value, const PropertyCallbackInfo<void> &info) {
+    JNIEnv *env = JNIWrapper::getEnvironment();
+    JNILocalFrame localFrame(env, 1);
+
+    Isolate *isolate = info.GetIsolate();
+    HandleScope scope(isolate);
+
+    v8::Local<v8::External> ext;
+
+    ext = info.Data().As<v8::External>();
+    auto * cb = static_cast<JNIV8ObjectJavaAccessorHolder*>(ext->Value());
+
+    jobject jobj = nullptr;
+    jvalue jval;
+    memset(&jval, 0, sizeof(jvalue));
+
+    if (!cb->isStatic) {
+        ext = info.This()->GetInternalField(0).As<v8::External>();
+        auto *v8Object = reinterpret_cast<JNIV8Object *>(ext->Value());
+
+        jobj = v8Object->getJObject();
+    }
+
+    JNIV8MarshallingError res;
+    res = JNIV8Marshalling::convertV8ValueToJavaValue(env, value, cb->propertyType, &jval);
+    if(res != JNIV8MarshallingError::kOk) {
+        throwPropertyMarshallingError(isolate, res, cb, value);
+        return;
+    }
+
+    JNIV8Marshalling::setJavaField(env, cb->propertyType, cb->javaClass, cb->javaFieldId, jobj, jval);
+}
+
 void JNIV8ClassInfo::v8JavaMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& args) {
     JNIEnv *env = JNIWrapper::getEnvironment();
     JNILocalFrame localFrame(env);
@@ -382,9 +443,10 @@ void JNIV8ClassInfo::v8MethodCallback(const v8::FunctionCallbackInfo<v8::Value>&
     }
 }
 
-JNIV8ClassInfoContainer::JNIV8ClassInfoContainer(JNIV8ObjectType type, const std::string& canonicalName, JNIV8ObjectInitializer i,
+JNIV8ClassInfoContainer::JNIV8ClassInfoContainer(size_t classId, JNIV8ObjectType type, const std::string& canonicalName, JNIV8ObjectInitializer i,
                                            JNIV8ObjectCreator c, size_t s, JNIV8ClassInfoContainer *baseClassInfo) :
-        type(type), canonicalName(canonicalName), initializer(i), creator(c), size(s), baseClassInfo(baseClassInfo) {
+        classId(classId), type(type), canonicalName(canonicalName), initializer(i), creator(c), size(s), baseClassInfo(baseClassInfo),
+        bindingsResolved(false), createFromJavaOnly(false) {
     if(baseClassInfo) {
         if (!creator) {
             creator = baseClassInfo->creator;
@@ -564,6 +626,28 @@ void JNIV8ClassInfo::registerStaticJavaAccessor(const std::string &propertyName,
     _registerJavaAccessor(holder);
 }
 
+void JNIV8ClassInfo::registerJavaFieldAccessor(const std::string& propertyName, const JNIV8JavaValue& propertyType, jfieldID fieldId, bool isReadOnly) {
+    auto * holder = new JNIV8ObjectJavaAccessorHolder(propertyType);
+    holder->propertyName = propertyName;
+    holder->javaGetterId = nullptr;
+    holder->javaSetterId = nullptr;
+    holder->javaFieldId = fieldId;
+    holder->isReadOnly = isReadOnly;
+    holder->isStatic = false;
+    _registerJavaAccessor(holder);
+}
+
+void JNIV8ClassInfo::registerStaticJavaFieldAccessor(const std::string& propertyName, const JNIV8JavaValue& propertyType, jfieldID fieldId, bool isReadOnly) {
+    auto * holder = new JNIV8ObjectJavaAccessorHolder(propertyType);
+    holder->propertyName = propertyName;
+    holder->javaGetterId = nullptr;
+    holder->javaSetterId = nullptr;
+    holder->javaFieldId = fieldId;
+    holder->isReadOnly = isReadOnly;
+    holder->isStatic = true;
+    _registerJavaAccessor(holder);
+}
+
 void JNIV8ClassInfo::registerAccessor(const std::string& propertyName,
                       JNIV8ObjectAccessorGetterCallback getter,
                       JNIV8ObjectAccessorSetterCallback setter) {
@@ -613,7 +697,6 @@ void JNIV8ClassInfo::registerStaticAccessor(const EJNIV8ObjectSymbolType symbol,
 void JNIV8ClassInfo::_registerJavaMethod(JNIV8ObjectJavaCallbackHolder *holder) {
     Isolate* isolate = engine->getIsolate();
     HandleScope scope(isolate);
-    Local<Context> context = engine->getContext();
     Local<FunctionTemplate> ft = Local<FunctionTemplate>::New(isolate, functionTemplate);
 
     JNIEnv *env = JNIWrapper::getEnvironment();
@@ -625,8 +708,8 @@ void JNIV8ClassInfo::_registerJavaMethod(JNIV8ObjectJavaCallbackHolder *holder)
     Local<Name> nameRef = _makeName(holder->methodName);
 
     if(holder->isStatic) {
-        Local<Function> f = ft->GetFunction(context).ToLocalChecked();
-        f->Set(context, nameRef, FunctionTemplate::New(isolate, v8JavaMethodCallback, data, Local<Signature>(), 0, ConstructorBehavior::kThrow)->GetFunction(context).ToLocalChecked());
+        // static members are stored on the template; the constructor is only instantiated when it is first used
+        ft->Set(nameRef, FunctionTemplate::New(isolate, v8JavaMethodCallback, data, Local<Signature>(), 0, ConstructorBehavior::kThrow));
     } else {
         // ofc functions belong on the prototype, and not on the actual instance for performance/memory reasons
         // but interestingly enough, we MUST store them there because they simply are not "copied" from the InstanceTemplate when using inherit later
@@ -653,9 +736,18 @@ void JNIV8ClassInfo::_registerJavaAccessor(JNIV8ObjectJavaAccessorHolder *holder
 
     Local<External> data = External::New(isolate, (void*)holder);
 
+    // accessors bound to fields read and write the field directly, without calling any java code
+    AccessorNameGetterCallback finalGetter = v8JavaAccessorGetterCallback;
     AccessorNameSetterCallback finalSetter = 0;
     v8::PropertyAttribute settings = v8::PropertyAttribute::None;
-    if(holder->javaSetterId) {
+    if(holder->javaFieldId) {
+        finalGetter = v8JavaFieldGetterCallback;
+        if(!holder->isReadOnly) {
+            finalSetter = v8JavaFieldSetterCallback;
+        } else {
+            settings = v8::PropertyAttribute::ReadOnly;
+        }
+    } else if(holder->javaSetterId) {
         finalSetter = v8JavaAccessorSetterCallback;
     } else {
         settings = v8::PropertyAttribute::ReadOnly;
@@ -664,20 +756,16 @@ void JNIV8ClassInfo::_registerJavaAccessor(JNIV8ObjectJavaAccessorHolder *holder
     Local<Name> nameRef = _makeName(holder->propertyName);
 
     if(holder->isStatic) {
-        Local<Function> f = ft->GetFunction(isolate->GetCurrentContext()).ToLocalChecked();
-        f->SetAccessor(engine->getContext(), nameRef,
-                       v8JavaAccessorGetterCallback, finalSetter,
-                       data, DEFAULT, settings);
+        ft->SetNativeDataProperty(nameRef, finalGetter, finalSetter, data, settings);
     } else {
         Local<ObjectTemplate> instanceTpl = ft->InstanceTemplate();
-        instanceTpl->SetAccessor(nameRef,v8JavaAccessorGetterCallback, finalSetter, data, settings);
+        instanceTpl->SetAccessor(nameRef, finalGetter, finalSetter, data, settings);
     }
 }
 
 void JNIV8ClassInfo::_registerMethod(JNIV8ObjectCallbackHolder *holder) {
     Isolate* isolate = engine->getIsolate();
     HandleScope scope(isolate);
-    Local<Context> context = engine->getContext();
 
     Local<FunctionTemplate> ft = Local<FunctionTemplate>::New(isolate, functionTemplate);
 
@@ -687,9 +775,8 @@ void JNIV8ClassInfo::_registerMethod(JNIV8ObjectCallbackHolder *holder) {
     Local<Name> nameRef = _makeName(holder->methodName);
 
     if(holder->isStatic) {
-        Local<Function> f = ft->GetFunction(context).ToLocalChecked();
-        f->Set(context, nameRef,
-               FunctionTemplate::New(isolate, v8MethodCallback, data, Local<Signature>(), 0, ConstructorBehavior::kThrow)->GetFunction(context).ToLocalChecked());
+        // static members are stored on the template; the constructor is only instantiated when it is first used
+        ft->Set(nameRef, FunctionTemplate::New(isolate, v8MethodCallback, data, Local<Signature>(), 0, ConstructorBehavior::kThrow));
     } else {
         // ofc functions belong on the prototype, and not on the actual instance for performance/memory reasons
         // but interestingly enough, we MUST store them there because they simply are not "copied" from the InstanceTemplate when using inherit later
@@ -705,7 +792,6 @@ void JNIV8ClassInfo::_registerMethod(JNIV8ObjectCallbackHolder *holder) {
 void JNIV8ClassInfo::_registerAccessor(JNIV8ObjectAccessorHolder *holder) {
     Isolate* isolate = engine->getIsolate();
     HandleScope scope(isolate);
-    Local<Context> context = engine->getContext();
     Local<FunctionTemplate> ft = Local<FunctionTemplate>::New(isolate, functionTemplate);
 
     accessorHolders.push_back(holder);
@@ -722,10 +808,7 @@ void JNIV8ClassInfo::_registerAccessor(JNIV8ObjectAccessorHolder *holder) {
     Local<Name> nameRef = _makeName(holder->propertyName);
 
     if(holder->isStatic) {
-        Local<Function> f = ft->GetFunction(context).ToLocalChecked();
-        f->SetAccessor(context, nameRef,
-                       v8AccessorGetterCallback, finalSetter,
-                       data, DEFAULT, settings);
+        ft->SetNativeDataProperty(nameRef, v8AccessorGetterCallback, finalSetter, data, settings);
     } else {
         Local<ObjectTemplate> instanceTpl = ft->InstanceTemplate();
         instanceTpl->SetAccessor(nameRef,
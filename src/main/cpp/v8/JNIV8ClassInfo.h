@@ -84,12 +84,14 @@ enum EJNIV8ObjectSymbolType {
 };
 
 /**
- * internal struct for storing information for property accessor bound to java methods
+ * internal struct for storing information for property accessor bound to java methods or fields
  */
 struct JNIV8ObjectJavaAccessorHolder {
     std::string propertyName;
     jmethodID javaGetterId;
     jmethodID javaSetterId;
+    jfieldID javaFieldId = nullptr;
+    bool isReadOnly = false;
     jclass javaClass;
     JNIV8JavaValue propertyType;
     bool isStatic;
@@ -208,6 +210,8 @@ private:
     void registerStaticJavaMethod(const std::string& methodName, jmethodID methodId, const JNIV8JavaValue& returnType, std::vector<JNIV8JavaValue> *arguments);
     void registerJavaAccessor(const std::string& propertyName, const JNIV8JavaValue& propertyType, jmethodID getterId, jmethodID setterId);
     void registerStaticJavaAccessor(const std::string& propertyName, const JNIV8JavaValue& propertyType, jmethodID getterId, jmethodID setterId);
+    void registerJavaFieldAccessor(const std::string& propertyName, const JNIV8JavaValue& propertyType, jfieldID fieldId, bool isReadOnly);
+    void registerStaticJavaFieldAccessor(const std::string& propertyName, const JNIV8JavaValue& propertyType, jfieldID fieldId, bool isReadOnly);
 
     v8::Local<v8::Name> _makeName(std::string name);
     std::string _makeSymbolString(EJNIV8ObjectSymbolType symbol);
@@ -234,6 +238,8 @@ private:
 
     static void v8JavaAccessorGetterCallback(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value> &info);
     static void v8JavaAccessorSetterCallback(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &info);
+    static void v8JavaFieldGetterCallback(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value> &info);
+    static void v8JavaFieldSetterCallback(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &info);
     static void v8JavaMethodCallback(const v8::FunctionCallbackInfo<v8::Value>& args);
     static void v8AccessorGetterCallback(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value> &info);
     static void v8AccessorSetterCallback(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &info);
@@ -245,6 +251,33 @@ private:
 typedef void(*JNIV8ObjectInitializer)(JNIV8ClassInfo *info);
 typedef JNIRetainedRef<JNIV8Object>(*JNIV8ObjectCreator)(JNIV8ClassInfo *info, v8::Persistent<v8::Object> *jsObj, jobjectArray arguments);
 
+/**
+ * a java method or property binding declared by the generated V8Binding class
+ * resolved once per process (method ids, parsed type signatures) and registered with every engine
+ */
+struct JNIV8JavaBinding {
+    enum class Kind {
+        kMethod,
+        kAccessor,
+        kFieldAccessor
+    };
+
+    Kind kind;
+    bool isStatic;
+    bool isReadOnly;
+    std::string name;
+    // return type for methods, property type for accessors
+    JNIV8JavaValue type;
+    // argument types for methods; nullptr for methods taking variable arguments
+    std::vector<JNIV8JavaValue> *arguments;
+    jmethodID methodId, getterId, setterId;
+    jfieldID fieldId;
+
+    JNIV8JavaBinding(Kind kind, const std::string& name, const JNIV8JavaValue& type) :
+            kind(kind), isStatic(false), isReadOnly(false), name(name), type(type), arguments(nullptr),
+            methodId(nullptr), getterId(nullptr), setterId(nullptr), fieldId(nullptr) {};
+};
+
 /**
  * internal container object for managing all class info instances (one for each v8 engine) of an object
  */
@@ -253,17 +286,23 @@ struct JNIV8ClassInfoContainer {
     friend class JNIV8Wrapper;
     friend class JNIV8ClassInfo;
 private:
-    JNIV8ClassInfoContainer(JNIV8ObjectType type, const std::string& canonicalName, JNIV8ObjectInitializer i, JNIV8ObjectCreator c, size_t size, JNIV8ClassInfoContainer *baseClassInfo);
+    JNIV8ClassInfoContainer(size_t classId, JNIV8ObjectType type, const std::string& canonicalName, JNIV8ObjectInitializer i, JNIV8ObjectCreator c, size_t size, JNIV8ClassInfoContainer *baseClassInfo);
 
+    // id assigned by JNIWrapper; also indexes the class infos of each engine
+    size_t classId;
     JNIV8ObjectType type;
     JNIV8ClassInfoContainer *baseClassInfo;
     size_t size;
     std::string canonicalName;
     JNIV8ObjectInitializer initializer;
     JNIV8ObjectCreator creator;
-    std::vector<JNIV8ClassInfo*> classInfos;
 
     jclass clsObject, clsBinding;
+
+    // bindings of clsBinding; resolved when the class is first used by any engine (guarded by JNIV8Wrapper::_mutexEnv)
+    bool bindingsResolved;
+    bool createFromJavaOnly;
+    std::vector<JNIV8JavaBinding> javaBindings;
 };
 
 #endif //TRADINGLIB_SAMPLE_V8CLASSINFO_H
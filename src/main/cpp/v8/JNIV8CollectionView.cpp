@@ -0,0 +1,463 @@
+//
+// Created on 19.10.26.
+//
+
+#include "JNIV8CollectionView.h"
+
+/**
+ * internal struct for storing the java collection backing a view
+ */
+struct JNIV8CollectionViewHolder {
+    v8::Persistent<v8::Object> persistent;
+    jobject collection;
+    JNIV8CollectionViewType type;
+};
+
+// internal field 0 is reserved and stays empty: objects with an external in field 0 are treated as JNIV8Objects
+static const int kViewHolderField = 1;
+
+decltype(JNIV8CollectionView::_jniList) JNIV8CollectionView::_jniList = {0};
+decltype(JNIV8CollectionView::_jniMap) JNIV8CollectionView::_jniMap = {0};
+decltype(JNIV8CollectionView::_jniCollection) JNIV8CollectionView::_jniCollection = {0};
+decltype(JNIV8CollectionView::_jniArray) JNIV8CollectionView::_jniArray = {0};
+
+/**
+ * cache JNI class references
+ */
+void JNIV8CollectionView::initJNICache() {
+    JNIEnv *env = JNIWrapper::getEnvironment();
+
+    _jniList.clazz = (jclass)env->NewGlobalRef(env->FindClass("java/util/List"));
+    _jniList.sizeId = env->GetMethodID(_jniList.clazz, "size", "()I");
+    _jniList.getId = env->GetMethodID(_jniList.clazz, "get", "(I)Ljava/lang/Object;");
+    _jniList.setId = env->GetMethodID(_jniList.clazz, "set", "(ILjava/lang/Object;)Ljava/lang/Object;");
+    _jniList.addId = env->GetMethodID(_jniList.clazz, "add", "(Ljava/lang/Object;)Z");
+
+    _jniMap.clazz = (jclass)env->NewGlobalRef(env->FindClass("java/util/Map"));
+    _jniMap.getId = env->GetMethodID(_jniMap.clazz, "get", "(Ljava/lang/Object;)Ljava/lang/Object;");
+    _jniMap.putId = env->GetMethodID(_jniMap.clazz, "put", "(Ljava/lang/Object;Ljava/lang/Object;)Ljava/lang/Object;");
+    _jniMap.containsKeyId = env->GetMethodID(_jniMap.clazz, "containsKey", "(Ljava/lang/Object;)Z");
+    _jniMap.removeId = env->GetMethodID(_jniMap.clazz, "remove", "(Ljava/lang/Object;)Ljava/lang/Object;");
+    _jniMap.keySetId = env->GetMethodID(_jniMap.clazz, "keySet", "()Ljava/util/Set;");
+
+    _jniCollection.clazz = (jclass)env->NewGlobalRef(env->FindClass("java/util/Collection"));
+    _jniCollection.toArrayId = env->GetMethodID(_jniCollection.clazz, "toArray", "()[Ljava/lang/Object;");
+
+    _jniArray.objectArrayClazz = (jclass)env->NewGlobalRef(env->FindClass("[Ljava/lang/Object;"));
+    _jniArray.doubleArrayClazz = (jclass)env->NewGlobalRef(env->FindClass("[D"));
+    _jniArray.floatArrayClazz = (jclass)env->NewGlobalRef(env->FindClass("[F"));
+    _jniArray.intArrayClazz = (jclass)env->NewGlobalRef(env->FindClass("[I"));
+    _jniArray.longArrayClazz = (jclass)env->NewGlobalRef(env->FindClass("[J"));
+}
+
+bool JNIV8CollectionView::getArrayViewType(jobject array, JNIV8CollectionViewType *type) {
+    JNIEnv *env = JNIWrapper::getEnvironment();
+    if (env->IsInstanceOf(array, _jniArray.objectArrayClazz)) {
+        *type = JNIV8CollectionViewType::kObjectArray;
+    } else if (env->IsInstanceOf(array, _jniArray.doubleArrayClazz)) {
+        *type = JNIV8CollectionViewType::kDoubleArray;
+    } else if (env->IsInstanceOf(array, _jniArray.floatArrayClazz)) {
+        *type = JNIV8CollectionViewType::kFloatArray;
+    } else if (env->IsInstanceOf(array, _jniArray.intArrayClazz)) {
+        *type = JNIV8CollectionViewType::kIntArray;
+    } else if (env->IsInstanceOf(array, _jniArray.longArrayClazz)) {
+        *type = JNIV8CollectionViewType::kLongArray;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+template<typename T>
+static JNIV8CollectionViewHolder* getViewHolder(const v8::PropertyCallbackInfo<T> &info) {
+    return static_cast<JNIV8CollectionViewHolder*>(info.Holder()->GetAlignedPointerFromInternalField(kViewHolderField));
+}
+
+/**
+ * forwards a pending java exception to v8
+ * returns true if there was an exception
+ */
+static bool forwardPendingException(JNIEnv *env, v8::Isolate *isolate) {
+    if (!env->ExceptionCheck()) return false;
+    BGJSV8Engine::GetInstance(isolate)->forwardJNIExceptionToV8();
+    return true;
+}
+
+v8::MaybeLocal<v8::Object> JNIV8CollectionView::create(BGJSV8Engine *engine, jobject collection, JNIV8CollectionViewType type) {
+    JNIEnv *env = JNIWrapper::getEnvironment();
+    v8::Isolate *isolate = engine->getIsolate();
+    v8::EscapableHandleScope scope(isolate);
+    v8::Local<v8::Context> context = engine->getContext();
+
+    v8::Local<v8::Function> constructorRef;
+    if (!getViewConstructor(type != JNIV8CollectionViewType::kMap).ToLocal(&constructorRef)) {
+        return v8::MaybeLocal<v8::Object>();
+    }
+    v8::Local<v8::Object> objRef;
+    if (!constructorRef->NewInstance(context).ToLocal(&objRef)) {
+        return v8::MaybeLocal<v8::Object>();
+    }
+
+    auto *holder = new JNIV8CollectionViewHolder();
+    holder->collection = env->NewGlobalRef(collection);
+    holder->type = type;
+    objRef->SetAlignedPointerInInternalField(kViewHolderField, holder);
+
+    // the java reference is kept until the view is garbage collected
+    holder->persistent.Reset(isolate, objRef);
+    holder->persistent.SetWeak((void*)holder, weakPersistentCallback, v8::WeakCallbackType::kParameter);
+
+    return scope.Escape(objRef);
+}
+
+void JNIV8CollectionView::weakPersistentCallback(const v8::WeakCallbackInfo<void>& data) {
+    // V8 12.4 requires Reset() in the first-pass callback (node must be FREE)
+    auto *holder = reinterpret_cast<JNIV8CollectionViewHolder*>(data.GetParameter());
+    holder->persistent.Reset();
+
+    data.SetSecondPassCallback([](const v8::WeakCallbackInfo<void>& data) {
+        JNIEnv *env = JNIWrapper::getEnvironment();
+        auto *holder = reinterpret_cast<JNIV8CollectionViewHolder*>(data.GetParameter());
+        env->DeleteGlobalRef(holder->collection);
+        delete holder;
+    });
+}
+
+v8::MaybeLocal<v8::Function> JNIV8CollectionView::getViewConstructor(bool indexed) {
+    v8::Isolate* isolate = v8::Isolate::GetCurrent();
+    v8::EscapableHandleScope scope(isolate);
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+
+    v8::Local<v8::Value> localRef;
+    v8::Local<v8::Function> funcRef;
+
+    // constructors are created once per context and stored in a private of the context global
+    auto privateKey = v8::Private::ForApi(isolate, v8::String::NewFromUtf8(isolate, indexed ? "JNIV8CollectionView:indexed" : "JNIV8CollectionView:named").ToLocalChecked());
+    auto privateValue = context->Global()->GetPrivate(context, privateKey);
+    if (privateValue.ToLocal(&localRef) && localRef->IsFunction()) {
+        return scope.Escape(localRef.As<v8::Function>());
+    }
+
+    v8::Local<v8::FunctionTemplate> ft = v8::FunctionTemplate::New(isolate);
+    v8::Local<v8::ObjectTemplate> instanceTpl = ft->InstanceTemplate();
+    instanceTpl->SetInternalFieldCount(kViewHolderField + 1);
+
+    if (indexed) {
+        ft->SetClassName(v8::String::NewFromUtf8Literal(isolate, "JavaList"));
+        instanceTpl->SetHandler(v8::IndexedPropertyHandlerConfiguration(
+                v8IndexedGetterCallback, v8IndexedSetterCallback, v8IndexedQueryCallback, nullptr, v8IndexedEnumeratorCallback));
+        instanceTpl->SetNativeDataProperty(v8::String::NewFromUtf8Literal(isolate, "length"), v8LengthGetterCallback, nullptr,
+                                           v8::Local<v8::Value>(), (v8::PropertyAttribute)(v8::ReadOnly | v8::DontEnum | v8::DontDelete));
+
+        // array likes can use the generic iteration methods of Array.prototype
+        v8::Local<v8::ObjectTemplate> prototypeTpl = ft->PrototypeTemplate();
+        prototypeTpl->SetIntrinsicDataProperty(v8::Symbol::GetIterator(isolate), v8::kArrayProto_values, v8::DontEnum);
+        prototypeTpl->SetIntrinsicDataProperty(v8::String::NewFromUtf8Literal(isolate, "values"), v8::kArrayProto_values, v8::DontEnum);
+        prototypeTpl->SetIntrinsicDataProperty(v8::String::NewFromUtf8Literal(isolate, "keys"), v8::kArrayProto_keys, v8::DontEnum);
+        prototypeTpl->SetIntrinsicDataProperty(v8::String::NewFromUtf8Literal(isolate, "entries"), v8::kArrayProto_entries, v8::DontEnum);
+        prototypeTpl->SetIntrinsicDataProperty(v8::String::NewFromUtf8Literal(isolate, "forEach"), v8::kArrayProto_forEach, v8::DontEnum);
+    } else {
+        ft->SetClassName(v8::String::NewFromUtf8Literal(isolate, "JavaMap"));
+        instanceTpl->SetHandler(v8::NamedPropertyHandlerConfiguration(
+                v8NamedGetterCallback, v8NamedSetterCallback, v8NamedQueryCallback, v8NamedDeleterCallback, v8NamedEnumeratorCallback,
+                v8::Local<v8::Value>(), v8::PropertyHandlerFlags::kOnlyInterceptStrings));
+    }
+
+    if (!ft->GetFunction(context).ToLocal(&funcRef)) {
+        return v8::MaybeLocal<v8::Function>();
+    }
+
+    // store in context globals private
+    context->Global()->SetPrivate(context, privateKey, funcRef);
+
+    return scope.Escape(funcRef);
+}
+
+jint JNIV8CollectionView::getLength(JNIEnv *env, JNIV8CollectionViewHolder *holder) {
+    if (holder->type == JNIV8CollectionViewType::kList) {
+        return env->CallIntMethod(holder->collection, _jniList.sizeId);
+    }
+    return env->GetArrayLength((jarray)holder->collection);
+}
+
+bool JNIV8CollectionView::getElement(JNIEnv *env, JNIV8CollectionViewHolder *holder, uint32_t index, v8::Local<v8::Value> *value) {
+    v8::Isolate *isolate = v8::Isolate::GetCurrent();
+    jsize idx = (jsize)index;
+
+    switch (holder->type) {
+        case JNIV8CollectionViewType::kList: {
+            jobject element = env->CallObjectMethod(holder->collection, _jniList.getId, idx);
+            if (forwardPendingException(env, isolate)) return false;
+            *value = JNIV8Marshalling::jobject2v8value(element);
+            env->DeleteLocalRef(element);
+            break;
+        }
+        case JNIV8CollectionViewType::kObjectArray: {
+            jobject element = env->GetObjectArrayElement((jobjectArray)holder->collection, idx);
+            if (forwardPendingException(env, isolate)) return false;
+            *value = JNIV8Marshalling::jobject2v8value(element);
+            env->DeleteLocalRef(element);
+            break;
+        }
+        case JNIV8CollectionViewType::kDoubleArray: {
+            jdouble element;
+            env->GetDoubleArrayRegion((jdoubleArray)holder->collection, idx, 1, &element);
+            *value = v8::Number::New(isolate, element);
+            break;
+        }
+        case JNIV8CollectionViewType::kFloatArray: {
+            jfloat element;
+            env->GetFloatArrayRegion((jfloatArray)holder->collection, idx, 1, &element);
+            *value = v8::Number::New(isolate, element);
+            break;
+        }
+        case JNIV8CollectionViewType::kIntArray: {
+            jint element;
+            env->GetIntArrayRegion((jintArray)holder->collection, idx, 1, &element);
+            *value = v8::Integer::New(isolate, element);
+            break;
+        }
+        case JNIV8CollectionViewType::kLongArray: {
+            jlong element;
+            env->GetLongArrayRegion((jlongArray)holder->collection, idx, 1, &element);
+            *value = v8::Number::New(isolate, (double)element);
+            break;
+        }
+        default:
+            return false;
+    }
+    return !forwardPendingException(env, isolate);
+}
+
+bool JNIV8CollectionView::setElement(JNIEnv *env, JNIV8CollectionViewHolder *holder, uint32_t index, jint length, v8::Local<v8::Value> value) {
+    v8::Isolate *isolate = v8::Isolate::GetCurrent();
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+    jsize idx = (jsize)index;
+
+    switch (holder->type) {
+        case JNIV8CollectionViewType::kList: {
+            jobject element = JNIV8Marshalling::v8value2jobject(value);
+            if (idx == length) {
+                // assigning to the first index past the end appends, like it does for js arrays
+                env->CallBooleanMethod(holder->collection, _jniList.addId, element);
+            } else {
+                env->DeleteLocalRef(env->CallObjectMethod(holder->collection, _jniList.setId, idx, element));
+            }
+            env->DeleteLocalRef(element);
+            break;
+        }
+        case JNIV8CollectionViewType::kObjectArray: {
+            jobject element = JNIV8Marshalling::v8value2jobject(value);
+            env->SetObjectArrayElement((jobjectArray)holder->collection, idx, element);
+            env->DeleteLocalRef(element);
+            break;
+        }
+        case JNIV8CollectionViewType::kDoubleArray: {
+            jdouble element;
+            if (!value->NumberValue(context).To(&element)) return false;
+            env->SetDoubleArrayRegion((jdoubleArray)holder->collection, idx, 1, &element);
+            break;
+        }
+        case JNIV8CollectionViewType::kFloatArray: {
+            double number;
+            if (!value->NumberValue(context).To(&number)) return false;
+            jfloat element = (jfloat)number;
+            env->SetFloatArrayRegion((jfloatArray)holder->collection, idx, 1, &element);
+            break;
+        }
+        case JNIV8CollectionViewType::kIntArray: {
+            jint element;
+            if (!value->Int32Value(context).To(&element)) return false;
+            env->SetIntArrayRegion((jintArray)holder->collection, idx, 1, &element);
+            break;
+        }
+        case JNIV8CollectionViewType::kLongArray: {
+            int64_t number;
+            if (!value->IntegerValue(context).To(&number)) return false;
+            jlong element = (jlong)number;
+            env->SetLongArrayRegion((jlongArray)holder->collection, idx, 1, &element);
+            break;
+        }
+        default:
+            return false;
+    }
+    return !forwardPendingException(env, isolate);
+}
+
+void JNIV8CollectionView::v8LengthGetterCallback(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value> &info) {
+    JNIEnv *env = JNIWrapper::getEnvironment();
+    auto *holder = getViewHolder(info);
+
+    jint length = getLength(env, holder);
+    if (forwardPendingException(env, info.GetIsolate())) return;
+    info.GetReturnValue().Set(length);
+}
+
+v8::Intercepted JNIV8CollectionView::v8IndexedGetterCallback(uint32_t index, const v8::PropertyCallbackInfo<v8::Value> &info) {
+    JNIEnv *env = JNIWrapper::getEnvironment();
+    JNILocalFrame localFrame(env, 1);
+
+    v8::Isolate *isolate = info.GetIsolate();
+    v8::HandleScope scope(isolate);
+    auto *holder = getViewHolder(info);
+
+    jint length = getLength(env, holder);
+    if (forwardPendingException(env, isolate)) return v8::Intercepted::kYes;
+    if ((int64_t)index >= (int64_t)length) return v8::Intercepted::kNo;
+
+    v8::Local<v8::Value> value;
+    if (getElement(env, holder, index, &value)) {
+        info.GetReturnValue().Set(value);
+    }
+    return v8::Intercepted::kYes;
+}
+
+v8::Intercepted JNIV8CollectionView::v8IndexedSetterCallback(uint32_t index, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &info) {
+    JNIEnv *env = JNIWrapper::getEnvironment();
+    JNILocalFrame localFrame(env, 1);
+
+    v8::Isolate *isolate = info.GetIsolate();
+    v8::HandleScope scope(isolate);
+    auto *holder = getViewHolder(info);
+
+    jint length = getLength(env, holder);
+    if (forwardPendingException(env, isolate)) return v8::Intercepted::kYes;
+
+    // arrays have a fixed size; lists can grow by one element at a time
+    // compared as int64_t: for empty arrays, maxIndex is -1
+    int64_t maxIndex = holder->type == JNIV8CollectionViewType::kList ? (int64_t)length : (int64_t)length - 1;
+    if (length < 0 || (int64_t)index > maxIndex) {
+        ThrowV8RangeError("index " + std::to_string(index) + " is out of bounds for java collection of length " + std::to_string(length));
+        return v8::Intercepted::kYes;
+    }
+
+    setElement(env, holder, index, length, value);
+    return v8::Intercepted::kYes;
+}
+
+v8::Intercepted JNIV8CollectionView::v8IndexedQueryCallback(uint32_t index, const v8::PropertyCallbackInfo<v8::Integer> &info) {
+    JNIEnv *env = JNIWrapper::getEnvironment();
+    auto *holder = getViewHolder(info);
+
+    jint length = getLength(env, holder);
+    if (forwardPendingException(env, info.GetIsolate())) return v8::Intercepted::kYes;
+    if ((int64_t)index >= (int64_t)length) return v8::Intercepted::kNo;
+
+    info.GetReturnValue().Set((int32_t)v8::None);
+    return v8::Intercepted::kYes;
+}
+
+void JNIV8CollectionView::v8IndexedEnumeratorCallback(const v8::PropertyCallbackInfo<v8::Array> &info) {
+    JNIEnv *env = JNIWrapper::getEnvironment();
+    v8::Isolate *isolate = info.GetIsolate();
+    v8::HandleScope scope(isolate);
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+    auto *holder = getViewHolder(info);
+
+    jint length = getLength(env, holder);
+    if (forwardPendingException(env, isolate)) return;
+
+    v8::Local<v8::Array> indices = v8::Array::New(isolate, length);
+    for (jint i = 0; i < length; i++) {
+        indices->Set(context, (uint32_t)i, v8::Integer::New(isolate, i)).Check();
+    }
+    info.GetReturnValue().Set(indices);
+}
+
+v8::Intercepted JNIV8CollectionView::v8NamedGetterCallback(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value> &info) {
+    JNIEnv *env = JNIWrapper::getEnvironment();
+    JNILocalFrame localFrame(env, 2);
+
+    v8::Isolate *isolate = info.GetIsolate();
+    v8::HandleScope scope(isolate);
+    auto *holder = getViewHolder(info);
+
+    jstring key = JNIV8Marshalling::v8string2jstring(property.As<v8::String>());
+    jobject value = env->CallObjectMethod(holder->collection, _jniMap.getId, key);
+    if (forwardPendingException(env, isolate)) return v8::Intercepted::kYes;
+
+    // keys that do not exist are looked up on the prototype chain as usual
+    if (!value) {
+        jboolean exists = env->CallBooleanMethod(holder->collection, _jniMap.containsKeyId, key);
+        if (forwardPendingException(env, isolate)) return v8::Intercepted::kYes;
+        if (!exists) return v8::Intercepted::kNo;
+    }
+
+    info.GetReturnValue().Set(JNIV8Marshalling::jobject2v8value(value));
+    return v8::Intercepted::kYes;
+}
+
+v8::Intercepted JNIV8CollectionView::v8NamedSetterCallback(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &info) {
+    JNIEnv *env = JNIWrapper::getEnvironment();
+    JNILocalFrame localFrame(env, 3);
+
+    v8::Isolate *isolate = info.GetIsolate();
+    v8::HandleScope scope(isolate);
+    auto *holder = getViewHolder(info);
+
+    jstring key = JNIV8Marshalling::v8string2jstring(property.As<v8::String>());
+    jobject element = JNIV8Marshalling::v8value2jobject(value);
+    env->CallObjectMethod(holder->collection, _jniMap.putId, key, element);
+    forwardPendingException(env, isolate);
+    return v8::Intercepted::kYes;
+}
+
+v8::Intercepted JNIV8CollectionView::v8NamedQueryCallback(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Integer> &info) {
+    JNIEnv *env = JNIWrapper::getEnvironment();
+    JNILocalFrame localFrame(env, 1);
+
+    v8::Isolate *isolate = info.GetIsolate();
+    v8::HandleScope scope(isolate);
+    auto *holder = getViewHolder(info);
+
+    jstring key = JNIV8Marshalling::v8string2jstring(property.As<v8::String>());
+    jboolean exists = env->CallBooleanMethod(holder->collection, _jniMap.containsKeyId, key);
+    if (forwardPendingException(env, isolate)) return v8::Intercepted::kYes;
+    if (!exists) return v8::Intercepted::kNo;
+
+    info.GetReturnValue().Set((int32_t)v8::None);
+    return v8::Intercepted::kYes;
+}
+
+v8::Intercepted JNIV8CollectionView::v8NamedDeleterCallback(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Boolean> &info) {
+    JNIEnv *env = JNIWrapper::getEnvironment();
+    JNILocalFrame localFrame(env, 2);
+
+    v8::Isolate *isolate = info.GetIsolate();
+    v8::HandleScope scope(isolate);
+    auto *holder = getViewHolder(info);
+
+    jstring key = JNIV8Marshalling::v8string2jstring(property.As<v8::String>());
+    env->CallObjectMethod(holder->collection, _jniMap.removeId, key);
+    if (forwardPendingException(env, isolate)) return v8::Intercepted::kYes;
+
+    info.GetReturnValue().Set(true);
+    return v8::Intercepted::kYes;
+}
+
+void JNIV8CollectionView::v8NamedEnumeratorCallback(const v8::PropertyCallbackInfo<v8::Array> &info) {
+    JNIEnv *env = JNIWrapper::getEnvironment();
+    JNILocalFrame localFrame(env, 2);
+
+    v8::Isolate *isolate = info.GetIsolate();
+    v8::HandleScope scope(isolate);
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+    auto *holder = getViewHolder(info);
+
+    jobject keySet = env->CallObjectMethod(holder->collection, _jniMap.keySetId);
+    if (forwardPendingException(env, isolate)) return;
+    auto keys = (jobjectArray)env->CallObjectMethod(keySet, _jniCollection.toArrayId);
+    if (forwardPendingException(env, isolate)) return;
+
+    jsize numKeys = env->GetArrayLength(keys);
+    v8::Local<v8::Array> names = v8::Array::New(isolate, numKeys);
+    v8::Local<v8::String> nameRef;
+    for (jsize i = 0; i < numKeys; i++) {
+        jobject key = env->GetObjectArrayElement(keys, i);
+        bool converted = JNIV8Marshalling::jobject2v8value(key)->ToString(context).ToLocal(&nameRef);
+        env->DeleteLocalRef(key);
+        if (!converted) return;
+        names->Set(context, (uint32_t)i, nameRef).Check();
+    }
+    info.GetReturnValue().Set(names);
+}
@@ -0,0 +1,96 @@
+//
+// Created on 19.10.26.
+//
+
+#ifndef ANDROID_TRADINGLIB_SAMPLE_JNIV8COLLECTIONVIEW_H
+#define ANDROID_TRADINGLIB_SAMPLE_JNIV8COLLECTIONVIEW_H
+
+#include "JNIV8Wrapper.h"
+
+struct JNIV8CollectionViewHolder;
+
+/**
+ * kind of java collection backing a view
+ */
+enum class JNIV8CollectionViewType {
+    kList,
+    kMap,
+    kObjectArray,
+    kDoubleArray,
+    kFloatArray,
+    kIntArray,
+    kLongArray
+};
+
+/**
+ * Exposes a java List, Map or array as a live js object
+ * Elements are not copied; they are read from and written to the java collection when accessed from js, using
+ * property interceptors. List and array views have a length property and can be iterated like arrays.
+ */
+class JNIV8CollectionView {
+public:
+    /**
+     * creates a view for the specified collection
+     * the collection must match the specified type
+     */
+    static v8::MaybeLocal<v8::Object> create(BGJSV8Engine *engine, jobject collection, JNIV8CollectionViewType type);
+
+    /**
+     * determines the view type for a java array
+     * returns false if the object is not an array or the array type is not supported
+     */
+    static bool getArrayViewType(jobject array, JNIV8CollectionViewType *type);
+
+    /**
+     * cache JNI class references
+     */
+    static void initJNICache();
+private:
+    static v8::MaybeLocal<v8::Function> getViewConstructor(bool indexed);
+
+    static void weakPersistentCallback(const v8::WeakCallbackInfo<void>& data);
+
+    static jint getLength(JNIEnv *env, JNIV8CollectionViewHolder *holder);
+    static bool getElement(JNIEnv *env, JNIV8CollectionViewHolder *holder, uint32_t index, v8::Local<v8::Value> *value);
+    static bool setElement(JNIEnv *env, JNIV8CollectionViewHolder *holder, uint32_t index, jint length, v8::Local<v8::Value> value);
+
+    static void v8LengthGetterCallback(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value> &info);
+    static v8::Intercepted v8IndexedGetterCallback(uint32_t index, const v8::PropertyCallbackInfo<v8::Value> &info);
+    static v8::Intercepted v8IndexedSetterCallback(uint32_t index, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &info);
+    static v8::Intercepted v8IndexedQueryCallback(uint32_t index, const v8::PropertyCallbackInfo<v8::Integer> &info);
+    static void v8IndexedEnumeratorCallback(const v8::PropertyCallbackInfo<v8::Array> &info);
+    static v8::Intercepted v8NamedGetterCallback(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Value> &info);
+    static v8::Intercepted v8NamedSetterCallback(v8::Local<v8::Name> property, v8::Local<v8::Value> value, const v8::PropertyCallbackInfo<void> &info);
+    static v8::Intercepted v8NamedQueryCallback(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Integer> &info);
+    static v8::Intercepted v8NamedDeleterCallback(v8::Local<v8::Name> property, const v8::PropertyCallbackInfo<v8::Boolean> &info);
+    static void v8NamedEnumeratorCallback(const v8::PropertyCallbackInfo<v8::Array> &info);
+
+    static struct {
+        jclass clazz;
+        jmethodID sizeId;
+        jmethodID getId;
+        jmethodID setId;
+        jmethodID addId;
+    } _jniList;
+    static struct {
+        jclass clazz;
+        jmethodID getId;
+        jmethodID putId;
+        jmethodID containsKeyId;
+        jmethodID removeId;
+        jmethodID keySetId;
+    } _jniMap;
+    static struct {
+        jclass clazz;
+        jmethodID toArrayId;
+    } _jniCollection;
+    static struct {
+        jclass objectArrayClazz;
+        jclass doubleArrayClazz;
+        jclass floatArrayClazz;
+        jclass intArrayClazz;
+        jclass longArrayClazz;
+    } _jniArray;
+};
+
+#endif //ANDROID_TRADINGLIB_SAMPLE_JNIV8COLLECTIONVIEW_H
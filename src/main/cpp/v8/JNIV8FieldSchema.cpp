@@ -0,0 +1,320 @@
+//
+// Created on 19.10.26.
+//
+
+#include "JNIV8FieldSchema.h"
+#include "JNIV8Array.h"
+#include "JNIV8GenericObject.h"
+
+#include <cmath>
+
+BGJS_JNI_LINK(JNIV8FieldSchema, "ag/boersego/bgjs/V8FieldSchema");
+
+JNIV8FieldSchema::JNIV8FieldSchema(jobject obj, JNIClassInfo *info) : JNIScope(obj, info) {
+}
+
+JNIV8FieldSchema::~JNIV8FieldSchema() {
+    if (!_engine) {
+        return;
+    }
+    V8Locker l(_engine->getIsolate(), __FUNCTION__);
+    for (auto field : _fields) {
+        field->key.Reset();
+        delete field;
+    }
+    _fields.clear();
+    _recordTemplate.Reset();
+}
+
+void JNIV8FieldSchema::initializeJNIBindings(JNIClassInfo *info, bool isReload) {
+    info->registerNativeMethod("initNativeV8FieldSchema", "(Lag/boersego/bgjs/V8Engine;[Ljava/lang/String;[I)V", (void*)JNIV8FieldSchema::jniInitNativeV8FieldSchema);
+    info->registerNativeMethod("createRecord", "([D)Lag/boersego/bgjs/JNIV8GenericObject;", (void*)JNIV8FieldSchema::jniCreateRecord);
+    info->registerNativeMethod("createRecord", "([Ljava/lang/Object;)Lag/boersego/bgjs/JNIV8GenericObject;", (void*)JNIV8FieldSchema::jniCreateRecordFromObjects);
+    info->registerNativeMethod("createRecords", "([D)Lag/boersego/bgjs/JNIV8Array;", (void*)JNIV8FieldSchema::jniCreateRecords);
+}
+
+BGJSV8Engine* JNIV8FieldSchema::getEngine() const {
+    return _engine.get();
+}
+
+JNILocalRef<JNIV8FieldSchema> JNIV8FieldSchema::wrapForEngine(JNIEnv *env, jobject schema, BGJSV8Engine *engine) {
+    auto ptr = JNIWrapper::wrapObject<JNIV8FieldSchema>(schema);
+    if (!ptr) {
+        env->ThrowNew(env->FindClass("java/lang/NullPointerException"), "schema must not be null");
+        return nullptr;
+    }
+    if (ptr->getEngine() != engine) {
+        env->ThrowNew(env->FindClass("java/lang/IllegalArgumentException"),
+                      "V8FieldSchema was created for a different engine");
+        return nullptr;
+    }
+    return ptr;
+}
+
+size_t JNIV8FieldSchema::getFieldCount() const {
+    return _fields.size();
+}
+
+bool JNIV8FieldSchema::readFields(v8::Local<v8::Context> context, v8::Local<v8::Object> object, jdouble *target) const {
+    v8::Isolate *isolate = context->GetIsolate();
+
+    for (size_t i = 0; i < _fields.size(); i++) {
+        Field *field = _fields[i];
+        v8::Local<v8::Value> valueRef;
+        if (!object->Get(context, v8::Local<v8::String>::New(isolate, field->key)).ToLocal(&valueRef)) {
+            return false;
+        }
+
+        switch (field->type) {
+            case JNIV8JavaValueType::kBoolean:
+                target[i] = valueRef->BooleanValue(isolate) ? 1 : 0;
+                break;
+            case JNIV8JavaValueType::kInteger: {
+                v8::Maybe<int32_t> maybeInt = valueRef->Int32Value(context);
+                if (maybeInt.IsNothing()) return false;
+                target[i] = maybeInt.FromJust();
+                break;
+            }
+            default: {
+                v8::Maybe<double> maybeNumber = valueRef->NumberValue(context);
+                if (maybeNumber.IsNothing()) return false;
+                target[i] = maybeNumber.FromJust();
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+bool JNIV8FieldSchema::writeFields(v8::Local<v8::Context> context, v8::Local<v8::Object> object, const jdouble *source) const {
+    v8::Isolate *isolate = context->GetIsolate();
+
+    for (size_t i = 0; i < _fields.size(); i++) {
+        Field *field = _fields[i];
+        const double value = source[i];
+        v8::Local<v8::Value> valueRef;
+
+        switch (field->type) {
+            case JNIV8JavaValueType::kBoolean:
+                valueRef = v8::Boolean::New(isolate, value != 0 && !std::isnan(value));
+                break;
+            case JNIV8JavaValueType::kInteger: {
+                int32_t intValue = 0;
+                if (!std::isnan(value)) {
+                    intValue = (int32_t)std::max((double)INT32_MIN, std::min((double)INT32_MAX, value));
+                }
+                valueRef = v8::Integer::New(isolate, intValue);
+                break;
+            }
+            default:
+                valueRef = v8::Number::New(isolate, value);
+                break;
+        }
+
+        if (object->Set(context, v8::Local<v8::String>::New(isolate, field->key), valueRef).IsNothing()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+v8::MaybeLocal<v8::Object> JNIV8FieldSchema::newRecord(v8::Local<v8::Context> context) const {
+    v8::Isolate *isolate = context->GetIsolate();
+    return v8::Local<v8::ObjectTemplate>::New(isolate, _recordTemplate)->NewInstance(context);
+}
+
+void JNIV8FieldSchema::jniInitNativeV8FieldSchema(JNIEnv *env, jobject obj, jobject engineObj, jobjectArray keys, jintArray types) {
+    auto schema = JNIWrapper::wrapObject<JNIV8FieldSchema>(obj);
+    auto engine = JNIWrapper::wrapObject<BGJSV8Engine>(engineObj);
+    if (!engine || !keys || !types) {
+        env->ThrowNew(env->FindClass("java/lang/NullPointerException"), "engine, keys and types must not be null");
+        return;
+    }
+
+    const jsize numFields = env->GetArrayLength(keys);
+    if (env->GetArrayLength(types) != numFields) {
+        env->ThrowNew(env->FindClass("java/lang/IllegalArgumentException"), "keys and types must have the same length");
+        return;
+    }
+
+    v8::Isolate* isolate = engine->getIsolate();
+    if (!isolate) {
+        // getIsolate has already thrown an exception
+        return;
+    }
+    V8Locker l(isolate, __FUNCTION__);
+    v8::Isolate::Scope isolateScope(isolate);
+    v8::HandleScope scope(isolate);
+
+    schema->_engine = JNIRetainedRef<BGJSV8Engine>::New(engine);
+
+    jint *typesArray = env->GetIntArrayElements(types, nullptr);
+    for (jsize i = 0; i < numFields; i++) {
+        auto key = (jstring) env->GetObjectArrayElement(keys, i);
+        if (!key) {
+            env->ThrowNew(env->FindClass("java/lang/NullPointerException"), "keys must not contain null");
+            break;
+        }
+
+        // keys are internalized once, so lookups can skip string conversion & hashing
+        const jchar *chars = env->GetStringChars(key, nullptr);
+        v8::Local<v8::String> stringRef = v8::String::NewFromTwoByte(isolate, chars, v8::NewStringType::kInternalized,
+                                                                     env->GetStringLength(key)).ToLocalChecked();
+        env->ReleaseStringChars(key, chars);
+        env->DeleteLocalRef(key);
+
+        auto field = new Field();
+        field->key.Reset(isolate, stringRef);
+        field->type = (JNIV8JavaValueType)typesArray[i];
+        schema->_fields.push_back(field);
+    }
+    env->ReleaseIntArrayElements(types, typesArray, JNI_ABORT);
+
+    // records are instantiated from a template that defines all fields up front, so every record gets the same map
+    // and property accesses in js stay monomorphic. Placeholders match the field types to avoid representation changes
+    // when the actual values are written (doubles use NaN, because 0 would be stored as a small integer)
+    v8::Local<v8::ObjectTemplate> templateRef = v8::ObjectTemplate::New(isolate);
+    for (auto field : schema->_fields) {
+        v8::Local<v8::Data> placeholderRef;
+        switch (field->type) {
+            case JNIV8JavaValueType::kBoolean:
+                placeholderRef = v8::False(isolate);
+                break;
+            case JNIV8JavaValueType::kInteger:
+                placeholderRef = v8::Integer::New(isolate, 0);
+                break;
+            default:
+                placeholderRef = v8::Number::New(isolate, NAN);
+                break;
+        }
+        templateRef->Set(v8::Local<v8::String>::New(isolate, field->key), placeholderRef);
+    }
+    schema->_recordTemplate.Reset(isolate, templateRef);
+}
+
+/**
+ * creates a single record from values.length == getFieldCount() doubles
+ */
+jobject JNIV8FieldSchema::jniCreateRecord(JNIEnv *env, jobject obj, jdoubleArray values) {
+    auto schema = JNIWrapper::wrapObject<JNIV8FieldSchema>(obj);
+    BGJSV8Engine *engine = schema->getEngine();
+    if (!values) {
+        env->ThrowNew(env->FindClass("java/lang/NullPointerException"), "values must not be null");
+        return nullptr;
+    }
+    const size_t numFields = schema->getFieldCount();
+    if ((size_t)env->GetArrayLength(values) != numFields) {
+        env->ThrowNew(env->FindClass("java/lang/IllegalArgumentException"), "values must contain exactly one value per field");
+        return nullptr;
+    }
+
+    v8::Isolate* isolate = engine->getIsolate();
+    V8Locker l(isolate, __FUNCTION__);
+    v8::MicrotasksScope taskScope(isolate, v8::MicrotasksScope::kRunMicrotasks);
+    v8::Isolate::Scope isolateScope(isolate);
+    v8::HandleScope scope(isolate);
+    v8::Local<v8::Context> context = engine->getContext();
+    v8::Context::Scope ctxScope(context);
+    v8::TryCatch try_catch(isolate);
+
+    std::vector<jdouble> source(numFields);
+    env->GetDoubleArrayRegion(values, 0, (jsize)numFields, source.data());
+
+    v8::Local<v8::Object> objRef;
+    if (!schema->newRecord(context).ToLocal(&objRef) || !schema->writeFields(context, objRef, source.data())) {
+        engine->forwardV8ExceptionToJNI(&try_catch);
+        return nullptr;
+    }
+
+    return JNIV8Wrapper::wrapObject<JNIV8GenericObject>(objRef)->getJObject();
+}
+
+/**
+ * creates a single record from values.length == getFieldCount() java objects
+ * values are converted like any other java value, the field types of the schema are not applied
+ */
+jobject JNIV8FieldSchema::jniCreateRecordFromObjects(JNIEnv *env, jobject obj, jobjectArray values) {
+    auto schema = JNIWrapper::wrapObject<JNIV8FieldSchema>(obj);
+    BGJSV8Engine *engine = schema->getEngine();
+    if (!values) {
+        env->ThrowNew(env->FindClass("java/lang/NullPointerException"), "values must not be null");
+        return nullptr;
+    }
+    const size_t numFields = schema->getFieldCount();
+    if ((size_t)env->GetArrayLength(values) != numFields) {
+        env->ThrowNew(env->FindClass("java/lang/IllegalArgumentException"), "values must contain exactly one value per field");
+        return nullptr;
+    }
+
+    v8::Isolate* isolate = engine->getIsolate();
+    V8Locker l(isolate, __FUNCTION__);
+    v8::MicrotasksScope taskScope(isolate, v8::MicrotasksScope::kRunMicrotasks);
+    v8::Isolate::Scope isolateScope(isolate);
+    v8::HandleScope scope(isolate);
+    v8::Local<v8::Context> context = engine->getContext();
+    v8::Context::Scope ctxScope(context);
+    v8::TryCatch try_catch(isolate);
+
+    v8::Local<v8::Object> objRef;
+    if (!schema->newRecord(context).ToLocal(&objRef)) {
+        engine->forwardV8ExceptionToJNI(&try_catch);
+        return nullptr;
+    }
+    for (size_t i = 0; i < numFields; i++) {
+        jobject value = env->GetObjectArrayElement(values, (jsize)i);
+        v8::Local<v8::Value> valueRef = JNIV8Marshalling::jobject2v8value(value);
+        env->DeleteLocalRef(value);
+        if (valueRef.IsEmpty() ||
+            objRef->Set(context, v8::Local<v8::String>::New(isolate, schema->_fields[i]->key), valueRef).IsNothing()) {
+            engine->forwardV8ExceptionToJNI(&try_catch);
+            return nullptr;
+        }
+    }
+
+    return JNIV8Wrapper::wrapObject<JNIV8GenericObject>(objRef)->getJObject();
+}
+
+/**
+ * creates an array of records; values contains getFieldCount() doubles per record, record after record
+ */
+jobject JNIV8FieldSchema::jniCreateRecords(JNIEnv *env, jobject obj, jdoubleArray values) {
+    auto schema = JNIWrapper::wrapObject<JNIV8FieldSchema>(obj);
+    BGJSV8Engine *engine = schema->getEngine();
+    if (!values) {
+        env->ThrowNew(env->FindClass("java/lang/NullPointerException"), "values must not be null");
+        return nullptr;
+    }
+    const size_t numFields = schema->getFieldCount();
+    const size_t numValues = (size_t)env->GetArrayLength(values);
+    if (!numFields || numValues % numFields) {
+        env->ThrowNew(env->FindClass("java/lang/IllegalArgumentException"), "values must contain a multiple of the field count");
+        return nullptr;
+    }
+    const size_t numRecords = numValues / numFields;
+
+    v8::Isolate* isolate = engine->getIsolate();
+    V8Locker l(isolate, __FUNCTION__);
+    v8::MicrotasksScope taskScope(isolate, v8::MicrotasksScope::kRunMicrotasks);
+    v8::Isolate::Scope isolateScope(isolate);
+    v8::HandleScope scope(isolate);
+    v8::Local<v8::Context> context = engine->getContext();
+    v8::Context::Scope ctxScope(context);
+    v8::TryCatch try_catch(isolate);
+
+    std::vector<jdouble> source(numValues);
+    env->GetDoubleArrayRegion(values, 0, (jsize)numValues, source.data());
+
+    v8::Local<v8::Array> arrayRef = v8::Array::New(isolate, (int)numRecords);
+    for (size_t i = 0; i < numRecords; i++) {
+        v8::HandleScope recordScope(isolate);
+        v8::Local<v8::Object> objRef;
+        if (!schema->newRecord(context).ToLocal(&objRef) ||
+            !schema->writeFields(context, objRef, source.data() + i * numFields) ||
+            arrayRef->Set(context, (uint32_t)i, objRef).IsNothing()) {
+            engine->forwardV8ExceptionToJNI(&try_catch);
+            return nullptr;
+        }
+    }
+
+    return JNIV8Wrapper::wrapObject<JNIV8Array>(arrayRef)->getJObject();
+}
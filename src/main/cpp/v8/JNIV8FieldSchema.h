@@ -0,0 +1,76 @@
+//
+// Created on 19.10.26.
+//
+
+#ifndef ANDROID_TRADINGLIB_SAMPLE_JNIV8FIELDSCHEMA_H
+#define ANDROID_TRADINGLIB_SAMPLE_JNIV8FIELDSCHEMA_H
+
+#include "JNIV8Wrapper.h"
+
+/**
+ * native counterpart of ag.boersego.bgjs.V8FieldSchema
+ * a fixed list of property names + primitive types that can be transferred between js objects
+ * and java double arrays in a single call
+ * records created from a schema all share the same hidden class, because they are instantiated from one
+ * object template that already contains every field in order
+ */
+class JNIV8FieldSchema : public JNIScope<JNIV8FieldSchema> {
+public:
+    JNIV8FieldSchema(jobject obj, JNIClassInfo *info);
+    virtual ~JNIV8FieldSchema();
+
+    /**
+     * returns the engine the schema was created for
+     */
+    BGJSV8Engine* getEngine() const;
+
+    /**
+     * returns the number of fields in the schema
+     */
+    size_t getFieldCount() const;
+
+    /**
+     * reads all fields of the object into target (which must have room for getFieldCount() values)
+     * requires the engine to be locked; returns false if a js exception was thrown
+     */
+    bool readFields(v8::Local<v8::Context> context, v8::Local<v8::Object> object, jdouble *target) const;
+
+    /**
+     * writes all fields from source to the object
+     * requires the engine to be locked; returns false if a js exception was thrown
+     */
+    bool writeFields(v8::Local<v8::Context> context, v8::Local<v8::Object> object, const jdouble *source) const;
+
+    /**
+     * creates a new object that has all fields of the schema, in schema order
+     * fields are initialized with placeholders matching their type and are meant to be overwritten with writeFields
+     * requires the engine to be locked
+     */
+    v8::MaybeLocal<v8::Object> newRecord(v8::Local<v8::Context> context) const;
+
+    /**
+     * wraps a java V8FieldSchema and makes sure it was created for the specified engine
+     * throws a java exception and returns nullptr otherwise
+     */
+    static JNILocalRef<JNIV8FieldSchema> wrapForEngine(JNIEnv *env, jobject schema, BGJSV8Engine *engine);
+
+    static void initializeJNIBindings(JNIClassInfo *info, bool isReload);
+private:
+    struct Field {
+        v8::Persistent<v8::String> key;
+        JNIV8JavaValueType type;
+    };
+
+    static void jniInitNativeV8FieldSchema(JNIEnv *env, jobject obj, jobject engineObj, jobjectArray keys, jintArray types);
+    static jobject jniCreateRecord(JNIEnv *env, jobject obj, jdoubleArray values);
+    static jobject jniCreateRecordFromObjects(JNIEnv *env, jobject obj, jobjectArray values);
+    static jobject jniCreateRecords(JNIEnv *env, jobject obj, jdoubleArray values);
+
+    JNIRetainedRef<BGJSV8Engine> _engine;
+    std::vector<Field*> _fields;
+    v8::Persistent<v8::ObjectTemplate> _recordTemplate;
+};
+
+BGJS_JNI_LINK_DEF(JNIV8FieldSchema)
+
+#endif //ANDROID_TRADINGLIB_SAMPLE_JNIV8FIELDSCHEMA_H
@@ -15,10 +15,14 @@ struct JNIV8FunctionCallbackHolder {
     v8::Persistent<v8::Function> persistent;
     jobject jFuncRef;
     jmethodID callbackMethodId;
+    JNIV8FunctionHandlerType type;
 };
 
 decltype(JNIV8Function::_jniObject) JNIV8Function::_jniObject = {0};
 
+// argument lists up to this size are marshalled without heap allocations
+static const jint kMaxStackArguments = 8;
+
 /**
  * cache JNI class references
  */
@@ -56,6 +60,59 @@ void JNIV8Function::v8FunctionCallback(const v8::FunctionCallbackInfo<v8::Value>
 
     JNIV8FunctionCallbackHolder *holder = static_cast<JNIV8FunctionCallbackHolder*>(ext->Value());
 
+    // typed handlers: arguments are converted directly from js, missing arguments are treated as undefined
+    if (holder->type != JNIV8FunctionHandlerType::kGeneric) {
+        v8::Local<v8::Context> context = args.GetIsolate()->GetCurrentContext();
+        v8::Local<v8::String> stringRef;
+        jvalue jargs[2];
+
+        switch (holder->type) {
+            case JNIV8FunctionHandlerType::kDoubleToDouble: {
+                if (!args[1]->NumberValue(context).To(&jargs[0].d)) return;
+                jdouble result = env->CallDoubleMethodA(holder->jFuncRef, holder->callbackMethodId, jargs);
+                if (env->ExceptionCheck()) break;
+                args.GetReturnValue().Set(result);
+                return;
+            }
+            case JNIV8FunctionHandlerType::kDoubleDoubleToVoid: {
+                if (!args[1]->NumberValue(context).To(&jargs[0].d)) return;
+                if (!args[2]->NumberValue(context).To(&jargs[1].d)) return;
+                env->CallVoidMethodA(holder->jFuncRef, holder->callbackMethodId, jargs);
+                if (env->ExceptionCheck()) break;
+                return;
+            }
+            case JNIV8FunctionHandlerType::kIntToObject: {
+                if (!args[1]->Int32Value(context).To(&jargs[0].i)) return;
+                jobject result = env->CallObjectMethodA(holder->jFuncRef, holder->callbackMethodId, jargs);
+                if (env->ExceptionCheck()) break;
+                args.GetReturnValue().Set(JNIV8Marshalling::jobject2v8value(result));
+                return;
+            }
+            case JNIV8FunctionHandlerType::kStringToString: {
+                if (args[1]->IsNullOrUndefined()) {
+                    jargs[0].l = nullptr;
+                } else {
+                    if (!args[1]->ToString(context).ToLocal(&stringRef)) return;
+                    jargs[0].l = JNIV8Marshalling::v8string2jstring(stringRef);
+                }
+                jstring result = (jstring)env->CallObjectMethodA(holder->jFuncRef, holder->callbackMethodId, jargs);
+                if (env->ExceptionCheck()) break;
+                if (result) {
+                    args.GetReturnValue().Set(JNIV8Marshalling::jstring2v8string(result));
+                } else {
+                    args.GetReturnValue().SetNull();
+                }
+                return;
+            }
+            default:
+                JNI_ASSERT(false, "invalid JNIV8Function handler type");
+                return;
+        }
+
+        BGJSV8Engine::GetInstance(args.GetIsolate())->forwardJNIExceptionToV8();
+        return;
+    }
+
     jobject receiver = JNIV8Marshalling::v8value2jobject(args.This());
     jobjectArray arguments = nullptr;
     jobject value;
@@ -83,7 +140,13 @@ bool JNIV8Function::isWrappableV8Object(v8::Local<v8::Object> object) {
 
 void JNIV8Function::initializeJNIBindings(JNIClassInfo *info, bool isReload) {
     info->registerNativeMethod("Create", "(Lag/boersego/bgjs/V8Engine;Lag/boersego/bgjs/JNIV8Function$Handler;)Lag/boersego/bgjs/JNIV8Function;", (void*)JNIV8Function::jniCreate);
+    info->registerNativeMethod("CreateDoubleToDouble", "(Lag/boersego/bgjs/V8Engine;Lag/boersego/bgjs/JNIV8Function$DoubleToDoubleHandler;)Lag/boersego/bgjs/JNIV8Function;", (void*)JNIV8Function::jniCreateDoubleToDouble);
+    info->registerNativeMethod("CreateDoubleDoubleToVoid", "(Lag/boersego/bgjs/V8Engine;Lag/boersego/bgjs/JNIV8Function$DoubleDoubleToVoidHandler;)Lag/boersego/bgjs/JNIV8Function;", (void*)JNIV8Function::jniCreateDoubleDoubleToVoid);
+    info->registerNativeMethod("CreateIntToObject", "(Lag/boersego/bgjs/V8Engine;Lag/boersego/bgjs/JNIV8Function$IntToObjectHandler;)Lag/boersego/bgjs/JNIV8Function;", (void*)JNIV8Function::jniCreateIntToObject);
+    info->registerNativeMethod("CreateStringToString", "(Lag/boersego/bgjs/V8Engine;Lag/boersego/bgjs/JNIV8Function$StringToStringHandler;)Lag/boersego/bgjs/JNIV8Function;", (void*)JNIV8Function::jniCreateStringToString);
     info->registerNativeMethod("_callAsV8Function", "(ZIILjava/lang/Class;Ljava/lang/Object;Ljava/lang/String;[Ljava/lang/Object;)Ljava/lang/Object;", (void*)JNIV8Function::jniCallAsV8Function);
+    info->registerNativeMethod("_applyAsV8FunctionDouble", "(Ljava/lang/String;[DIIZ)D", (void*)JNIV8Function::jniApplyAsV8FunctionDouble);
+    info->registerNativeMethod("_callAsV8FunctionVoid", "(Ljava/lang/String;DD)V", (void*)JNIV8Function::jniCallAsV8FunctionVoid2);
 }
 
 jobject JNIV8Function::jniCallAsV8Function(JNIEnv *env, jobject obj, jboolean asConstructor, jint flags, jint type, jclass returnType, jobject receiver, jstring callContext, jobjectArray arguments) {
@@ -99,15 +162,12 @@ jobject JNIV8Function::jniCallAsV8Function(JNIEnv *env, jobject obj, jboolean as
     v8::Isolate* isolate = ptr->getEngine()->getIsolate();
 #ifdef V8_LOCK_LOGGING
     std::string ownerNameStr = std::string(__FUNCTION__) + ": " + JNIWrapper::jstring2string(callContext);
-    V8Locker l(isolate, ownerNameStr.c_str());
+    V8Session session(ptr->getEngine(), ownerNameStr.c_str());
 #else
-    V8Locker l(isolate, __FUNCTION__);
+    V8Session session(ptr->getEngine(), __FUNCTION__);
 #endif
-    v8::Isolate::Scope isolateScope(isolate);
     v8::HandleScope scope(isolate);
     v8::Local<v8::Context> context = ptr->getEngine()->getContext();
-    v8::Context::Scope ctxScope(context);
-    v8::MicrotasksScope taskScope(isolate, v8::MicrotasksScope::kRunMicrotasks);
 
     v8::TryCatch try_catch(isolate);
 
@@ -191,6 +251,100 @@ jobject JNIV8Function::jniCallAsV8Function(JNIEnv *env, jobject obj, jboolean as
     return jval.l;
 }
 
+jdouble JNIV8Function::jniApplyAsV8FunctionDouble(JNIEnv *env, jobject obj, jstring callContext, jdoubleArray arguments, jint offset, jint count, jboolean discardResult) {
+    // a null array is treated like an empty one
+    jsize numElements = arguments ? env->GetArrayLength(arguments) : 0;
+    if (offset < 0 || count < 0 || (size_t)offset + (size_t)count > (size_t)numElements) {
+        env->ThrowNew(env->FindClass("java/lang/IndexOutOfBoundsException"),
+                      "Arguments are out of bounds of the java array");
+        return 0;
+    }
+
+    // all arguments are copied with a single JNI call
+    jdouble stackValues[kMaxStackArguments];
+    jdouble *values = stackValues;
+    if (count > kMaxStackArguments) {
+        values = (jdouble*)malloc(sizeof(jdouble)*count);
+        if (!values) {
+            env->ThrowNew(env->FindClass("java/lang/OutOfMemoryError"), "Failed to allocate argument buffer");
+            return 0;
+        }
+    }
+    if (count) {
+        env->GetDoubleArrayRegion(arguments, offset, count, values);
+    }
+
+    jdouble result = callWithDoubleArguments(env, obj, callContext, __FUNCTION__, values, count, discardResult);
+    if (values != stackValues) {
+        free(values);
+    }
+    return result;
+}
+
+void JNIV8Function::jniCallAsV8FunctionVoid2(JNIEnv *env, jobject obj, jstring callContext, jdouble argument1, jdouble argument2) {
+    jdouble values[2] = {argument1, argument2};
+    callWithDoubleArguments(env, obj, callContext, __FUNCTION__, values, 2, true);
+}
+
+jdouble JNIV8Function::callWithDoubleArguments(JNIEnv *env, jobject obj, jstring callContext, const char *functionName, const jdouble *values, jint count, bool discardResult) {
+    auto ptr = JNIWrapper::wrapObject<JNIV8Function>(obj);
+    if(!ptr) {
+        env->ThrowNew(env->FindClass("java/lang/RuntimeException"),
+                      "Attempt to call method on disposed or invalid object");
+        return 0;
+    }
+
+    v8::Isolate* isolate = ptr->getEngine()->getIsolate();
+#ifdef V8_LOCK_LOGGING
+    std::string ownerNameStr = std::string(functionName) + ": " + JNIWrapper::jstring2string(callContext);
+    V8Session session(ptr->getEngine(), ownerNameStr.c_str());
+#else
+    V8Session session(ptr->getEngine(), functionName);
+#endif
+    v8::HandleScope scope(isolate);
+    v8::Local<v8::Context> context = ptr->getEngine()->getContext();
+
+    v8::TryCatch try_catch(isolate);
+
+    v8::Local<v8::Value> stackArgs[kMaxStackArguments];
+    v8::Local<v8::Value> *args = stackArgs;
+    if (count > kMaxStackArguments) {
+        args = (v8::Local<v8::Value>*)malloc(sizeof(v8::Local<v8::Value>)*count);
+        if (!args) {
+            env->ThrowNew(env->FindClass("java/lang/OutOfMemoryError"), "Failed to allocate argument buffer");
+            return 0;
+        }
+    }
+    for (jint i = 0; i < count; i++) {
+        args[i] = v8::Number::New(isolate, values[i]);
+    }
+
+    v8::MaybeLocal<v8::Value> maybeLocal = ptr->getJSObject().As<v8::Function>()->Call(context, v8::Null(isolate), count, args);
+    if (args != stackArgs) {
+        free(args);
+    }
+    if(env->ExceptionCheck()) {
+        return 0;
+    }
+
+    v8::Local<v8::Value> resultRef;
+    if (!maybeLocal.ToLocal<v8::Value>(&resultRef)) {
+        ptr->getEngine()->forwardV8ExceptionToJNI(&try_catch);
+        return 0;
+    }
+    if (discardResult) {
+        return 0;
+    }
+
+    // converted with javascript semantics: undefined and non numeric values become NaN
+    jdouble result;
+    if (!resultRef->NumberValue(context).To(&result)) {
+        ptr->getEngine()->forwardV8ExceptionToJNI(&try_catch);
+        return 0;
+    }
+    return result;
+}
+
 v8::MaybeLocal<v8::Function> JNIV8Function::getJNIV8FunctionBaseFunction() {
     v8::Isolate* isolate = v8::Isolate::GetCurrent();
     v8::EscapableHandleScope scope(isolate);
@@ -249,6 +403,26 @@ v8::MaybeLocal<v8::Function> JNIV8Function::getJNIV8FunctionBaseFunction() {
 }
 
 jobject JNIV8Function::jniCreate(JNIEnv *env, jobject obj, jobject engineObj, jobject handler) {
+    return createWithHandler(env, engineObj, handler, JNIV8FunctionHandlerType::kGeneric);
+}
+
+jobject JNIV8Function::jniCreateDoubleToDouble(JNIEnv *env, jobject obj, jobject engineObj, jobject handler) {
+    return createWithHandler(env, engineObj, handler, JNIV8FunctionHandlerType::kDoubleToDouble);
+}
+
+jobject JNIV8Function::jniCreateDoubleDoubleToVoid(JNIEnv *env, jobject obj, jobject engineObj, jobject handler) {
+    return createWithHandler(env, engineObj, handler, JNIV8FunctionHandlerType::kDoubleDoubleToVoid);
+}
+
+jobject JNIV8Function::jniCreateIntToObject(JNIEnv *env, jobject obj, jobject engineObj, jobject handler) {
+    return createWithHandler(env, engineObj, handler, JNIV8FunctionHandlerType::kIntToObject);
+}
+
+jobject JNIV8Function::jniCreateStringToString(JNIEnv *env, jobject obj, jobject engineObj, jobject handler) {
+    return createWithHandler(env, engineObj, handler, JNIV8FunctionHandlerType::kStringToString);
+}
+
+jobject JNIV8Function::createWithHandler(JNIEnv *env, jobject engineObj, jobject handler, JNIV8FunctionHandlerType type) {
     auto engine = JNIWrapper::wrapObject<BGJSV8Engine>(engineObj);
 
     v8::Isolate* isolate = engine->getIsolate();
@@ -260,7 +434,7 @@ jobject JNIV8Function::jniCreate(JNIEnv *env, jobject obj, jobject engineObj, jo
     v8::Context::Scope ctxScope(context);
 
     v8::Local<v8::Function> funcRef;
-    auto maybeFuncRef = createJavaBackedFunction(engine, handler);
+    auto maybeFuncRef = createJavaBackedFunction(engine, handler, type);
     if (!maybeFuncRef.ToLocal(&funcRef)) {
         // exception will already have been thrown at this point
         return nullptr;
@@ -269,7 +443,7 @@ jobject JNIV8Function::jniCreate(JNIEnv *env, jobject obj, jobject engineObj, jo
     return JNIV8Wrapper::wrapObject<JNIV8Function>(funcRef)->getJObject();
 }
 
-v8::MaybeLocal<v8::Function> JNIV8Function::createJavaBackedFunction(JNILocalRef<BGJSV8Engine> engine, jobject handler) {
+v8::MaybeLocal<v8::Function> JNIV8Function::createJavaBackedFunction(JNILocalRef<BGJSV8Engine> engine, jobject handler, JNIV8FunctionHandlerType type) {
     JNIEnv *env = JNIWrapper::getEnvironment();
 
     v8::Isolate* isolate = engine->getIsolate();
@@ -284,7 +458,28 @@ v8::MaybeLocal<v8::Function> JNIV8Function::createJavaBackedFunction(JNILocalRef
     // java reference is stored in the functions data parameter to be retrieved when called
     JNIV8FunctionCallbackHolder *holder = new JNIV8FunctionCallbackHolder();
     holder->jFuncRef = env->NewGlobalRef(handler);
-    holder->callbackMethodId = env->GetMethodID(env->GetObjectClass(handler), "Callback", "(Ljava/lang/Object;[Ljava/lang/Object;)Ljava/lang/Object;");
+    holder->type = type;
+    const char *callbackSignature;
+    switch (type) {
+        case JNIV8FunctionHandlerType::kDoubleToDouble:
+            callbackSignature = "(D)D";
+            break;
+        case JNIV8FunctionHandlerType::kDoubleDoubleToVoid:
+            callbackSignature = "(DD)V";
+            break;
+        case JNIV8FunctionHandlerType::kIntToObject:
+            callbackSignature = "(I)Ljava/lang/Object;";
+            break;
+        case JNIV8FunctionHandlerType::kStringToString:
+            callbackSignature = "(Ljava/lang/String;)Ljava/lang/String;";
+            break;
+        default:
+            callbackSignature = "(Ljava/lang/Object;[Ljava/lang/Object;)Ljava/lang/Object;";
+            break;
+    }
+    jclass handlerClass = env->GetObjectClass(handler);
+    holder->callbackMethodId = env->GetMethodID(handlerClass, "Callback", callbackSignature);
+    env->DeleteLocalRef(handlerClass);
 
     v8::Local<v8::External> data = v8::External::New(isolate, (void*)holder);
 
@@ -7,6 +7,18 @@
 
 #include "JNIV8Wrapper.h"
 
+/**
+ * signature of the java handler backing a function created from java
+ * everything except kGeneric is called with unboxed arguments and without allocating an argument array
+ */
+enum class JNIV8FunctionHandlerType {
+    kGeneric,                   // (Object receiver, Object[] arguments) -> Object
+    kDoubleToDouble,            // (double) -> double
+    kDoubleDoubleToVoid,        // (double, double) -> void
+    kIntToObject,               // (int) -> Object
+    kStringToString             // (String) -> String
+};
+
 class JNIV8Function : public JNIScope<JNIV8Function, JNIV8Object> {
 public:
     JNIV8Function(jobject obj, JNIClassInfo *info) : JNIScope(obj, info) {};
@@ -15,7 +27,13 @@ public:
     static void initializeJNIBindings(JNIClassInfo *info, bool isReload);
 
     static jobject jniCreate(JNIEnv *env, jobject obj, jobject engineObj, jobject handler);
+    static jobject jniCreateDoubleToDouble(JNIEnv *env, jobject obj, jobject engineObj, jobject handler);
+    static jobject jniCreateDoubleDoubleToVoid(JNIEnv *env, jobject obj, jobject engineObj, jobject handler);
+    static jobject jniCreateIntToObject(JNIEnv *env, jobject obj, jobject engineObj, jobject handler);
+    static jobject jniCreateStringToString(JNIEnv *env, jobject obj, jobject engineObj, jobject handler);
     static jobject jniCallAsV8Function(JNIEnv *env, jobject obj, jboolean asConstructor, jint flags, jint type, jclass returnType, jobject receiver, jstring callContext, jobjectArray arguments);
+    static jdouble jniApplyAsV8FunctionDouble(JNIEnv *env, jobject obj, jstring callContext, jdoubleArray arguments, jint offset, jint count, jboolean discardResult);
+    static void jniCallAsV8FunctionVoid2(JNIEnv *env, jobject obj, jstring callContext, jdouble argument1, jdouble argument2);
 
     /**
      * cache JNI class references
@@ -25,8 +43,10 @@ private:
     static struct {
         jclass clazz;
     } _jniObject;
+    static jdouble callWithDoubleArguments(JNIEnv *env, jobject obj, jstring callContext, const char *functionName, const jdouble *values, jint count, bool discardResult);
     static v8::MaybeLocal<v8::Function> getJNIV8FunctionBaseFunction();
-    static v8::MaybeLocal<v8::Function> createJavaBackedFunction(JNILocalRef<BGJSV8Engine> engine, jobject handler);
+    static jobject createWithHandler(JNIEnv *env, jobject engineObj, jobject handler, JNIV8FunctionHandlerType type);
+    static v8::MaybeLocal<v8::Function> createJavaBackedFunction(JNILocalRef<BGJSV8Engine> engine, jobject handler, JNIV8FunctionHandlerType type);
     static void v8FunctionCallback(const v8::FunctionCallbackInfo<v8::Value>& args);
 };
 
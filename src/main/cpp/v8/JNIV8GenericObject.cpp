@@ -13,6 +13,9 @@ bool JNIV8GenericObject::isWrappableV8Object(v8::Local<v8::Object> object) {
 
 void JNIV8GenericObject::initializeJNIBindings(JNIClassInfo *info, bool isReload) {
     info->registerNativeMethod("Create", "(Lag/boersego/bgjs/V8Engine;)Lag/boersego/bgjs/JNIV8GenericObject;", (void*)JNIV8GenericObject::jniCreate);
+    info->registerNativeMethod("CreateListView", "(Lag/boersego/bgjs/V8Engine;Ljava/util/List;)Lag/boersego/bgjs/JNIV8GenericObject;", (void*)JNIV8GenericObject::jniCreateListView);
+    info->registerNativeMethod("CreateMapView", "(Lag/boersego/bgjs/V8Engine;Ljava/util/Map;)Lag/boersego/bgjs/JNIV8GenericObject;", (void*)JNIV8GenericObject::jniCreateMapView);
+    info->registerNativeMethod("CreateArrayView", "(Lag/boersego/bgjs/V8Engine;Ljava/lang/Object;)Lag/boersego/bgjs/JNIV8GenericObject;", (void*)JNIV8GenericObject::jniCreateArrayView);
 }
 
 jobject JNIV8GenericObject::jniCreate(JNIEnv *env, jobject obj, jobject engineObj) {
@@ -31,4 +34,49 @@ jobject JNIV8GenericObject::jniCreate(JNIEnv *env, jobject obj, jobject engineOb
     objRef = v8::Object::New(isolate);
 
     return JNIV8Wrapper::wrapObject<JNIV8GenericObject>(objRef)->getJObject();
-}
\ No newline at end of file
+}
+
+jobject JNIV8GenericObject::jniCreateListView(JNIEnv *env, jobject obj, jobject engineObj, jobject list) {
+    return createCollectionView(env, engineObj, list, JNIV8CollectionViewType::kList);
+}
+
+jobject JNIV8GenericObject::jniCreateMapView(JNIEnv *env, jobject obj, jobject engineObj, jobject map) {
+    return createCollectionView(env, engineObj, map, JNIV8CollectionViewType::kMap);
+}
+
+jobject JNIV8GenericObject::jniCreateArrayView(JNIEnv *env, jobject obj, jobject engineObj, jobject array) {
+    JNIV8CollectionViewType type;
+    if (!array || !JNIV8CollectionView::getArrayViewType(array, &type)) {
+        env->ThrowNew(env->FindClass("java/lang/IllegalArgumentException"),
+                      "array must be an Object[], double[], float[], int[] or long[]");
+        return nullptr;
+    }
+    return createCollectionView(env, engineObj, array, type);
+}
+
+jobject JNIV8GenericObject::createCollectionView(JNIEnv *env, jobject engineObj, jobject collection, JNIV8CollectionViewType type) {
+    if (!collection) {
+        env->ThrowNew(env->FindClass("java/lang/NullPointerException"), "collection must not be null");
+        return nullptr;
+    }
+
+    auto engine = JNIWrapper::wrapObject<BGJSV8Engine>(engineObj);
+
+    v8::Isolate* isolate = engine->getIsolate();
+    V8Locker l(isolate, __FUNCTION__);
+    v8::MicrotasksScope taskScope(isolate, v8::MicrotasksScope::kRunMicrotasks);
+    v8::Isolate::Scope isolateScope(isolate);
+    v8::HandleScope scope(isolate);
+    v8::Local<v8::Context> context = engine->getContext();
+    v8::Context::Scope ctxScope(context);
+
+    v8::TryCatch try_catch(isolate);
+    v8::Local<v8::Object> objRef;
+
+    if (!JNIV8CollectionView::create(engine.get(), collection, type).ToLocal(&objRef)) {
+        engine->forwardV8ExceptionToJNI(&try_catch);
+        return nullptr;
+    }
+
+    return JNIV8Wrapper::wrapObject<JNIV8GenericObject>(objRef)->getJObject();
+}
@@ -6,6 +6,7 @@
 #define TRADINGLIB_SAMPLE_JNIV8GENERICOBJECT_H
 
 #include "JNIV8Object.h"
+#include "JNIV8CollectionView.h"
 
 class JNIV8GenericObject : public JNIScope<JNIV8GenericObject, JNIV8Object> {
 public:
@@ -15,6 +16,11 @@ public:
     static void initializeJNIBindings(JNIClassInfo *info, bool isReload);
 
     static jobject jniCreate(JNIEnv *env, jobject obj, jobject engineObj);
+    static jobject jniCreateListView(JNIEnv *env, jobject obj, jobject engineObj, jobject list);
+    static jobject jniCreateMapView(JNIEnv *env, jobject obj, jobject engineObj, jobject map);
+    static jobject jniCreateArrayView(JNIEnv *env, jobject obj, jobject engineObj, jobject array);
+private:
+    static jobject createCollectionView(JNIEnv *env, jobject engineObj, jobject collection, JNIV8CollectionViewType type);
 };
 
 BGJS_JNI_LINK_DEF(JNIV8GenericObject)
@@ -0,0 +1,56 @@
+//
+// Created on 19.10.26.
+//
+
+#include "JNIV8Key.h"
+
+BGJS_JNI_LINK(JNIV8Key, "ag/boersego/bgjs/V8Key");
+
+JNIV8Key::JNIV8Key(jobject obj, JNIClassInfo *info) : JNIScope(obj, info) {
+}
+
+JNIV8Key::~JNIV8Key() {
+    if (_engine && !_key.IsEmpty()) {
+        V8Locker l(_engine->getIsolate(), __FUNCTION__);
+        _key.Reset();
+    }
+}
+
+void JNIV8Key::initializeJNIBindings(JNIClassInfo *info, bool isReload) {
+    info->registerNativeMethod("initNativeV8Key", "(Lag/boersego/bgjs/V8Engine;Ljava/lang/String;)V", (void*)JNIV8Key::jniInitNativeV8Key);
+}
+
+BGJSV8Engine* JNIV8Key::getEngine() const {
+    return _engine.get();
+}
+
+v8::Local<v8::String> JNIV8Key::getV8String(v8::Isolate *isolate) const {
+    return v8::Local<v8::String>::New(isolate, _key);
+}
+
+void JNIV8Key::jniInitNativeV8Key(JNIEnv *env, jobject obj, jobject engineObj, jstring name) {
+    auto key = JNIWrapper::wrapObject<JNIV8Key>(obj);
+    auto engine = JNIWrapper::wrapObject<BGJSV8Engine>(engineObj);
+    if (!engine || !name) {
+        env->ThrowNew(env->FindClass("java/lang/NullPointerException"), "engine and name must not be null");
+        return;
+    }
+
+    v8::Isolate* isolate = engine->getIsolate();
+    if (!isolate) {
+        // getIsolate has already thrown an exception
+        return;
+    }
+    V8Locker l(isolate, __FUNCTION__);
+    v8::Isolate::Scope isolateScope(isolate);
+    v8::HandleScope scope(isolate);
+
+    // internalize once, so property lookups using this key can skip string conversion & hashing
+    const jchar *chars = env->GetStringChars(name, nullptr);
+    v8::Local<v8::String> stringRef = v8::String::NewFromTwoByte(isolate, chars, v8::NewStringType::kInternalized,
+                                                                 env->GetStringLength(name)).ToLocalChecked();
+    env->ReleaseStringChars(name, chars);
+
+    key->_key.Reset(isolate, stringRef);
+    key->_engine = JNIRetainedRef<BGJSV8Engine>::New(engine);
+}
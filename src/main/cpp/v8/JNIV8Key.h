@@ -0,0 +1,40 @@
+//
+// Created on 19.10.26.
+//
+
+#ifndef ANDROID_TRADINGLIB_SAMPLE_JNIV8KEY_H
+#define ANDROID_TRADINGLIB_SAMPLE_JNIV8KEY_H
+
+#include "JNIV8Wrapper.h"
+
+/**
+ * native counterpart of ag.boersego.bgjs.V8Key
+ * holds an internalized v8 string that can be reused for property access from java
+ * without converting the name on every call
+ */
+class JNIV8Key : public JNIScope<JNIV8Key> {
+public:
+    JNIV8Key(jobject obj, JNIClassInfo *info);
+    virtual ~JNIV8Key();
+
+    /**
+     * returns the engine the key was created for
+     */
+    BGJSV8Engine* getEngine() const;
+
+    /**
+     * returns the internalized string; requires the engine to be locked
+     */
+    v8::Local<v8::String> getV8String(v8::Isolate *isolate) const;
+
+    static void initializeJNIBindings(JNIClassInfo *info, bool isReload);
+private:
+    static void jniInitNativeV8Key(JNIEnv *env, jobject obj, jobject engineObj, jstring name);
+
+    JNIRetainedRef<BGJSV8Engine> _engine;
+    v8::Persistent<v8::String> _key;
+};
+
+BGJS_JNI_LINK_DEF(JNIV8Key)
+
+#endif //ANDROID_TRADINGLIB_SAMPLE_JNIV8KEY_H
@@ -4,6 +4,9 @@
 
 #include "JNIV8Marshalling.h"
 #include <cmath>
+#include <vector>
+#include <memory>
+#include <cstring>
 
 #include "../jni/JNIWrapper.h"
 #include "JNIV8Wrapper.h"
@@ -160,6 +163,12 @@ decltype(JNIV8Marshalling::_jniV8Object) JNIV8Marshalling::_jniV8Object = {0};
 decltype(JNIV8Marshalling::_jniObject) JNIV8Marshalling::_jniObject = {0};
 decltype(JNIV8Marshalling::_jniString) JNIV8Marshalling::_jniString = {0};
 decltype(JNIV8Marshalling::_jniVoid) JNIV8Marshalling::_jniVoid = {0};
+decltype(JNIV8Marshalling::_jniObjectArray) JNIV8Marshalling::_jniObjectArray = {0};
+decltype(JNIV8Marshalling::_jniMap) JNIV8Marshalling::_jniMap = {0};
+decltype(JNIV8Marshalling::_jniMapEntry) JNIV8Marshalling::_jniMapEntry = {0};
+decltype(JNIV8Marshalling::_jniCollection) JNIV8Marshalling::_jniCollection = {0};
+decltype(JNIV8Marshalling::_jniHashMap) JNIV8Marshalling::_jniHashMap = {0};
+decltype(JNIV8Marshalling::_jniArrayList) JNIV8Marshalling::_jniArrayList = {0};
 jobject JNIV8Marshalling::_undefined = nullptr;
 std::unordered_map<int, JNIV8JavaValueType> JNIV8Marshalling::_typeMap;
 
@@ -203,6 +212,22 @@ void JNIV8Marshalling::initJNICache() {
     _typeMap[env->CallIntMethod(_jniString.clazz, hashCodeId)] = JNIV8JavaValueType::kString;
     _jniVoid.clazz = (jclass)env->NewGlobalRef(env->FindClass("java/lang/Void"));
     _typeMap[env->CallIntMethod(_jniVoid.clazz, hashCodeId)] = JNIV8JavaValueType::kVoid;
+
+    // classes & methods required for converting object graphs
+    _jniMap.clazz = (jclass)env->NewGlobalRef(env->FindClass("java/util/Map"));
+    _jniMap.entrySetId = env->GetMethodID(_jniMap.clazz, "entrySet", "()Ljava/util/Set;");
+    _jniMapEntry.clazz = (jclass)env->NewGlobalRef(env->FindClass("java/util/Map$Entry"));
+    _jniMapEntry.getKeyId = env->GetMethodID(_jniMapEntry.clazz, "getKey", "()Ljava/lang/Object;");
+    _jniMapEntry.getValueId = env->GetMethodID(_jniMapEntry.clazz, "getValue", "()Ljava/lang/Object;");
+    _jniCollection.clazz = (jclass)env->NewGlobalRef(env->FindClass("java/util/Collection"));
+    _jniCollection.toArrayId = env->GetMethodID(_jniCollection.clazz, "toArray", "()[Ljava/lang/Object;");
+    _jniHashMap.clazz = (jclass)env->NewGlobalRef(env->FindClass("java/util/HashMap"));
+    _jniHashMap.initId = env->GetMethodID(_jniHashMap.clazz, "<init>", "(I)V");
+    _jniHashMap.putId = env->GetMethodID(_jniHashMap.clazz, "put", "(Ljava/lang/Object;Ljava/lang/Object;)Ljava/lang/Object;");
+    _jniArrayList.clazz = (jclass)env->NewGlobalRef(env->FindClass("java/util/ArrayList"));
+    _jniArrayList.initId = env->GetMethodID(_jniArrayList.clazz, "<init>", "(I)V");
+    _jniArrayList.addId = env->GetMethodID(_jniArrayList.clazz, "add", "(Ljava/lang/Object;)Z");
+    _jniObjectArray.clazz = (jclass)env->NewGlobalRef(env->FindClass("[Ljava/lang/Object;"));
 }
 
 /**
@@ -430,6 +455,203 @@ v8::Local<v8::Value> JNIV8Marshalling::callJavaMethod(JNIEnv *env, JNIV8JavaValu
 }
 
 
+/**
+ * reads a java field and converts it to a v8 value
+ * if object is null, the field is assumed to be static
+ */
+v8::Local<v8::Value> JNIV8Marshalling::getJavaField(JNIEnv *env, JNIV8JavaValue type, jclass clazz, jfieldID fieldId, jobject object) {
+    JNILocalFrame localFrame(env, 1);
+    v8::Isolate* isolate = v8::Isolate::GetCurrent();
+    v8::EscapableHandleScope handleScope(isolate);
+    v8::Local<v8::Value> result;
+
+    // boxed values are stored as objects
+    JNIV8JavaValueType valueType = type.valueType;
+    if (type.clazz) {
+        valueType = JNIV8JavaValueType::kObject;
+    }
+
+    switch(valueType) {
+        case JNIV8JavaValueType::kString:
+        case JNIV8JavaValueType::kObject:
+            result = JNIV8Marshalling::jobject2v8value(object ? env->GetObjectField(object, fieldId) :
+                                                       env->GetStaticObjectField(clazz, fieldId));
+            break;
+        case JNIV8JavaValueType::kBoolean:
+            result = v8::Boolean::New(isolate, object ? env->GetBooleanField(object, fieldId) :
+                                               env->GetStaticBooleanField(clazz, fieldId));
+            break;
+        case JNIV8JavaValueType::kByte:
+            result = v8::Number::New(isolate, object ? env->GetByteField(object, fieldId) :
+                                              env->GetStaticByteField(clazz, fieldId));
+            break;
+        case JNIV8JavaValueType::kCharacter: {
+            jchar value = object ? env->GetCharField(object, fieldId) : env->GetStaticCharField(clazz, fieldId);
+            v8::MaybeLocal<v8::String> maybeLocal = v8::String::NewFromTwoByte(isolate, &value, v8::NewStringType::kNormal, 1);
+            if(maybeLocal.IsEmpty()) {
+                result = v8::Undefined(isolate);
+            } else {
+                result = maybeLocal.ToLocalChecked();
+            }
+            break;
+        }
+        case JNIV8JavaValueType::kShort:
+            result = v8::Number::New(isolate, object ? env->GetShortField(object, fieldId) :
+                                              env->GetStaticShortField(clazz, fieldId));
+            break;
+        case JNIV8JavaValueType::kInteger:
+            result = v8::Number::New(isolate, object ? env->GetIntField(object, fieldId) :
+                                              env->GetStaticIntField(clazz, fieldId));
+            break;
+        case JNIV8JavaValueType::kLong:
+            result = v8::Number::New(isolate, object ? env->GetLongField(object, fieldId) :
+                                              env->GetStaticLongField(clazz, fieldId));
+            break;
+        case JNIV8JavaValueType::kFloat:
+            result = v8::Number::New(isolate, object ? env->GetFloatField(object, fieldId) :
+                                              env->GetStaticFloatField(clazz, fieldId));
+            break;
+        case JNIV8JavaValueType::kDouble:
+            result = v8::Number::New(isolate, object ? env->GetDoubleField(object, fieldId) :
+                                              env->GetStaticDoubleField(clazz, fieldId));
+            break;
+        case JNIV8JavaValueType::kVoid:
+            result = v8::Undefined(isolate);
+            break;
+    }
+
+    return handleScope.Escape(result);
+}
+
+/**
+ * writes a value previously converted with convertV8ValueToJavaValue to a java field
+ * if object is null, the field is assumed to be static
+ */
+void JNIV8Marshalling::setJavaField(JNIEnv *env, JNIV8JavaValue type, jclass clazz, jfieldID fieldId, jobject object, const jvalue &value) {
+    // boxed values are stored as objects
+    JNIV8JavaValueType valueType = type.valueType;
+    if (type.clazz) {
+        valueType = JNIV8JavaValueType::kObject;
+    }
+
+    switch(valueType) {
+        case JNIV8JavaValueType::kString:
+        case JNIV8JavaValueType::kObject:
+            if (object) env->SetObjectField(object, fieldId, value.l);
+            else env->SetStaticObjectField(clazz, fieldId, value.l);
+            break;
+        case JNIV8JavaValueType::kBoolean:
+            if (object) env->SetBooleanField(object, fieldId, value.z);
+            else env->SetStaticBooleanField(clazz, fieldId, value.z);
+            break;
+        case JNIV8JavaValueType::kByte:
+            if (object) env->SetByteField(object, fieldId, value.b);
+            else env->SetStaticByteField(clazz, fieldId, value.b);
+            break;
+        case JNIV8JavaValueType::kCharacter:
+            if (object) env->SetCharField(object, fieldId, value.c);
+            else env->SetStaticCharField(clazz, fieldId, value.c);
+            break;
+        case JNIV8JavaValueType::kShort:
+            if (object) env->SetShortField(object, fieldId, value.s);
+            else env->SetStaticShortField(clazz, fieldId, value.s);
+            break;
+        case JNIV8JavaValueType::kInteger:
+            if (object) env->SetIntField(object, fieldId, value.i);
+            else env->SetStaticIntField(clazz, fieldId, value.i);
+            break;
+        case JNIV8JavaValueType::kLong:
+            if (object) env->SetLongField(object, fieldId, value.j);
+            else env->SetStaticLongField(clazz, fieldId, value.j);
+            break;
+        case JNIV8JavaValueType::kFloat:
+            if (object) env->SetFloatField(object, fieldId, value.f);
+            else env->SetStaticFloatField(clazz, fieldId, value.f);
+            break;
+        case JNIV8JavaValueType::kDouble:
+            if (object) env->SetDoubleField(object, fieldId, value.d);
+            else env->SetStaticDoubleField(clazz, fieldId, value.d);
+            break;
+        case JNIV8JavaValueType::kVoid:
+            break;
+    }
+}
+
+// strings with at least this many characters are transferred without intermediate copies:
+// java strings become external v8 strings and external v8 strings are read in place
+static const jsize kExternalStringThreshold = 32 * 1024;
+
+/**
+ * owns the characters of a java string that was copied once into native memory
+ * the memory is released by v8 when the string is garbage collected
+ */
+template<typename Resource, typename CharType>
+class JNIV8ExternalString : public Resource {
+public:
+    JNIV8ExternalString(CharType *data, size_t length) : _data(data), _length(length) {}
+    ~JNIV8ExternalString() override {
+        free(_data);
+    }
+    const CharType* data() const override {
+        return _data;
+    }
+    size_t length() const override {
+        return _length;
+    }
+private:
+    CharType *_data;
+    size_t _length;
+};
+
+typedef JNIV8ExternalString<v8::String::ExternalOneByteStringResource, char> JNIV8ExternalOneByteString;
+typedef JNIV8ExternalString<v8::String::ExternalStringResource, uint16_t> JNIV8ExternalTwoByteString;
+
+/**
+ * creates an external v8 string from a large java string
+ * latin-1 only strings are stored with one byte per character
+ */
+static v8::MaybeLocal<v8::String> newExternalString(JNIEnv *env, v8::Isolate *isolate, jstring string, jsize len) {
+    const jchar *chars = env->GetStringCritical(string, nullptr);
+    if (!chars) {
+        return v8::MaybeLocal<v8::String>();
+    }
+
+    auto *oneByteData = (char*)malloc((size_t)len);
+    if (!oneByteData) {
+        env->ReleaseStringCritical(string, chars);
+        return v8::MaybeLocal<v8::String>();
+    }
+    jsize i = 0;
+    for (; i < len && chars[i] <= 0xFF; i++) {
+        oneByteData[i] = (char)chars[i];
+    }
+    if (i == len) {
+        env->ReleaseStringCritical(string, chars);
+        auto *resource = new JNIV8ExternalOneByteString(oneByteData, (size_t)len);
+        v8::MaybeLocal<v8::String> result = v8::String::NewExternalOneByte(isolate, resource);
+        // v8 only takes ownership of the resource if the string was created
+        if (result.IsEmpty()) {
+            delete resource;
+        }
+        return result;
+    }
+    free(oneByteData);
+
+    auto *twoByteData = (uint16_t*)malloc((size_t)len * sizeof(uint16_t));
+    if (!twoByteData) {
+        env->ReleaseStringCritical(string, chars);
+        return v8::MaybeLocal<v8::String>();
+    }
+    memcpy(twoByteData, chars, (size_t)len * sizeof(uint16_t));
+    env->ReleaseStringCritical(string, chars);
+    auto *resource = new JNIV8ExternalTwoByteString(twoByteData, (size_t)len);
+    v8::MaybeLocal<v8::String> result = v8::String::NewExternalTwoByte(isolate, resource);
+    if (result.IsEmpty()) {
+        delete resource;
+    }
+    return result;
+}
+
 /**
  * convert a jstring to a std::string
  */
@@ -450,7 +672,9 @@ v8::Local<v8::String> JNIV8Marshalling::jstring2v8string(jstring string) {
 
     len = env->GetStringLength(string);
 
-    if(len > 0) {
+    if(len >= kExternalStringThreshold && len <= v8::String::kMaxLength) {
+        maybeLocal = newExternalString(env, isolate, string, len);
+    } else if(len > 0) {
         const jchar *chars = env->GetStringChars(string, nullptr);
         maybeLocal = v8::String::NewFromTwoByte(isolate, chars, v8::NewStringType::kNormal, len);
         env->ReleaseStringChars(string, chars);
@@ -472,7 +696,27 @@ v8::Local<v8::String> JNIV8Marshalling::jstring2v8string(jstring string) {
  */
 jstring JNIV8Marshalling::v8string2jstring(v8::Local<v8::String> string) {
     JNIEnv *env = JNIWrapper::getEnvironment();
-    return env->NewString(*v8::String::Value(v8::Isolate::GetCurrent(), string), string->Length()); // returns "" when called with NULL,0
+    int len = string->Length();
+
+    if(len >= kExternalStringThreshold) {
+        // external strings (e.g. large strings passed in from java) are read in place
+        if(string->IsExternalTwoByte()) {
+            return env->NewString((const jchar*)string->GetExternalStringResource()->data(), len);
+        }
+        // external one byte strings are widened directly; everything else is written once into the buffer
+        std::unique_ptr<uint16_t[]> buffer(new uint16_t[len]);
+        if(string->IsExternalOneByte()) {
+            const char *data = string->GetExternalOneByteStringResource()->data();
+            for(int i = 0; i < len; i++) {
+                buffer[i] = (uint8_t)data[i];
+            }
+        } else {
+            string->Write(v8::Isolate::GetCurrent(), buffer.get(), 0, len, v8::String::NO_NULL_TERMINATION);
+        }
+        return env->NewString(buffer.get(), len);
+    }
+
+    return env->NewString(*v8::String::Value(v8::Isolate::GetCurrent(), string), len); // returns "" when called with NULL,0
 }
 
 /**
@@ -570,6 +814,172 @@ v8::Local<v8::Value> JNIV8Marshalling::jobject2v8value(jobject object) {
     return scope.Escape(resultRef);
 }
 
+// nesting depth at which object graphs are considered cyclic
+static const int kMaxGraphDepth = 256;
+
+bool JNIV8Marshalling::isGraphDepthExceeded(int depth) {
+    if (depth <= kMaxGraphDepth) return false;
+    ThrowV8RangeError("object graph exceeds the maximum depth of " + std::to_string(kMaxGraphDepth) + "; is it cyclic?");
+    return true;
+}
+
+/**
+ * convert a graph of java objects to v8 values
+ */
+v8::MaybeLocal<v8::Value> JNIV8Marshalling::jobjectGraph2v8value(jobject object) {
+    return jobjectGraph2v8value(JNIWrapper::getEnvironment(), object, 0);
+}
+
+v8::MaybeLocal<v8::Value> JNIV8Marshalling::jobjectGraph2v8value(JNIEnv *env, jobject object, int depth) {
+    v8::Isolate* isolate = v8::Isolate::GetCurrent();
+    v8::EscapableHandleScope scope(isolate);
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+
+    if (!object || env->IsSameObject(object, nullptr)) {
+        return scope.Escape(v8::Null(isolate).As<v8::Value>());
+    }
+
+    // the element array is released on every return path when the frame is popped
+    JNILocalFrame localFrame(env, 2);
+
+    bool isMap = env->IsInstanceOf(object, _jniMap.clazz);
+    jobjectArray elements;
+    if (isMap) {
+        jobject entrySet = env->CallObjectMethod(object, _jniMap.entrySetId);
+        elements = entrySet ? (jobjectArray)env->CallObjectMethod(entrySet, _jniCollection.toArrayId) : nullptr;
+        env->DeleteLocalRef(entrySet);
+    } else if (env->IsInstanceOf(object, _jniCollection.clazz)) {
+        elements = (jobjectArray)env->CallObjectMethod(object, _jniCollection.toArrayId);
+    } else if (env->IsInstanceOf(object, _jniObjectArray.clazz)) {
+        elements = (jobjectArray)object;
+    } else {
+        // leaf values
+        return scope.Escape(jobject2v8value(object));
+    }
+    if (env->ExceptionCheck()) {
+        BGJSV8Engine::GetInstance(isolate)->forwardJNIExceptionToV8();
+        return v8::MaybeLocal<v8::Value>();
+    }
+    if (isGraphDepthExceeded(depth)) {
+        return v8::MaybeLocal<v8::Value>();
+    }
+
+    jsize numElements = elements ? env->GetArrayLength(elements) : 0;
+    v8::Local<v8::Value> resultRef;
+
+    if (isMap) {
+        v8::Local<v8::Object> objectRef = v8::Object::New(isolate);
+        v8::Local<v8::Value> keyRef, valueRef;
+        v8::Local<v8::Name> nameRef;
+        for (jsize i = 0; i < numElements; i++) {
+            JNILocalFrame entryFrame(env, 3);
+            jobject entry = env->GetObjectArrayElement(elements, i);
+            jobject key = env->CallObjectMethod(entry, _jniMapEntry.getKeyId);
+            jobject value = env->CallObjectMethod(entry, _jniMapEntry.getValueId);
+            if (env->ExceptionCheck()) {
+                BGJSV8Engine::GetInstance(isolate)->forwardJNIExceptionToV8();
+                return v8::MaybeLocal<v8::Value>();
+            }
+            keyRef = jobject2v8value(key);
+            if (keyRef->IsName()) {
+                nameRef = keyRef.As<v8::Name>();
+            } else if (!keyRef->ToString(context).ToLocal(&nameRef)) {
+                return v8::MaybeLocal<v8::Value>();
+            }
+            if (!jobjectGraph2v8value(env, value, depth + 1).ToLocal(&valueRef) ||
+                objectRef->CreateDataProperty(context, nameRef, valueRef).IsNothing()) {
+                return v8::MaybeLocal<v8::Value>();
+            }
+        }
+        resultRef = objectRef;
+    } else {
+        std::vector<v8::Local<v8::Value>> values((size_t)numElements);
+        for (jsize i = 0; i < numElements; i++) {
+            JNILocalFrame elementFrame(env, 1);
+            jobject element = env->GetObjectArrayElement(elements, i);
+            if (!jobjectGraph2v8value(env, element, depth + 1).ToLocal(&values[i])) {
+                return v8::MaybeLocal<v8::Value>();
+            }
+        }
+        resultRef = v8::Array::New(isolate, values.data(), values.size());
+    }
+
+    return scope.Escape(resultRef);
+}
+
+/**
+ * convert a graph of v8 values to java objects
+ */
+bool JNIV8Marshalling::v8valueGraph2jobject(v8::Local<v8::Value> valueRef, jobject *result) {
+    return v8valueGraph2jobject(JNIWrapper::getEnvironment(), valueRef, 0, result);
+}
+
+bool JNIV8Marshalling::v8valueGraph2jobject(JNIEnv *env, v8::Local<v8::Value> valueRef, int depth, jobject *result) {
+    v8::Isolate* isolate = v8::Isolate::GetCurrent();
+    v8::HandleScope scope(isolate);
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+
+    bool isArray = valueRef->IsArray();
+    // only plain js objects are converted to maps; functions, promises, buffers and java backed objects
+    // (which always have internal fields) are wrapped as usual
+    bool isPlainObject = !isArray && valueRef->IsObject() && !valueRef->IsFunction() && !valueRef->IsProxy() &&
+            !valueRef->IsPromise() && !valueRef->IsArrayBuffer() && !valueRef->IsArrayBufferView() &&
+            !valueRef->IsDate() && !valueRef->IsRegExp() && !valueRef->IsMap() && !valueRef->IsSet() &&
+            !valueRef->IsSymbolObject() && valueRef.As<v8::Object>()->InternalFieldCount() == 0;
+
+    if (!isArray && !isPlainObject) {
+        *result = v8value2jobject(valueRef);
+        return true;
+    }
+    if (isGraphDepthExceeded(depth)) {
+        return false;
+    }
+
+    jobject element;
+    v8::Local<v8::Value> elementRef;
+
+    if (isArray) {
+        v8::Local<v8::Array> arrayRef = valueRef.As<v8::Array>();
+        uint32_t length = arrayRef->Length();
+        jobject list = env->NewObject(_jniArrayList.clazz, _jniArrayList.initId, (jint)length);
+        for (uint32_t i = 0; i < length; i++) {
+            if (!arrayRef->Get(context, i).ToLocal(&elementRef) ||
+                !v8valueGraph2jobject(env, elementRef, depth + 1, &element)) {
+                env->DeleteLocalRef(list);
+                return false;
+            }
+            env->CallBooleanMethod(list, _jniArrayList.addId, element);
+            env->DeleteLocalRef(element);
+        }
+        *result = list;
+        return true;
+    }
+
+    v8::Local<v8::Object> objectRef = valueRef.As<v8::Object>();
+    v8::Local<v8::Array> keysRef;
+    if (!objectRef->GetOwnPropertyNames(context, (v8::PropertyFilter)(v8::ONLY_ENUMERABLE | v8::SKIP_SYMBOLS),
+                                        v8::KeyConversionMode::kConvertToString).ToLocal(&keysRef)) {
+        return false;
+    }
+    uint32_t numKeys = keysRef->Length();
+    jobject map = env->NewObject(_jniHashMap.clazz, _jniHashMap.initId, (jint)numKeys);
+    v8::Local<v8::Value> keyRef;
+    for (uint32_t i = 0; i < numKeys; i++) {
+        if (!keysRef->Get(context, i).ToLocal(&keyRef) ||
+            !objectRef->Get(context, keyRef).ToLocal(&elementRef) ||
+            !v8valueGraph2jobject(env, elementRef, depth + 1, &element)) {
+            env->DeleteLocalRef(map);
+            return false;
+        }
+        jstring key = v8string2jstring(keyRef.As<v8::String>());
+        env->DeleteLocalRef(env->CallObjectMethod(map, _jniHashMap.putId, key, element));
+        env->DeleteLocalRef(key);
+        env->DeleteLocalRef(element);
+    }
+    *result = map;
+    return true;
+}
+
 /**
  * return an object representing undefined in java
  */
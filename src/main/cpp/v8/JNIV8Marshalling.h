@@ -106,6 +106,18 @@ public:
      */
     static v8::Local<v8::Value> callJavaMethod(JNIEnv *env, JNIV8JavaValue returnType, jclass clazz, jmethodID methodId, jobject object, jvalue *args);
 
+    /**
+     * reads a java field and converts it to a v8 value
+     * if object is null, the field is assumed to be static
+     */
+    static v8::Local<v8::Value> getJavaField(JNIEnv *env, JNIV8JavaValue type, jclass clazz, jfieldID fieldId, jobject object);
+
+    /**
+     * writes a value previously converted with convertV8ValueToJavaValue to a java field
+     * if object is null, the field is assumed to be static
+     */
+    static void setJavaField(JNIEnv *env, JNIV8JavaValue type, jclass clazz, jfieldID fieldId, jobject object, const jvalue &value);
+
     /**
      * convert a v8 value to an instance of Object
      */
@@ -116,6 +128,20 @@ public:
      */
     static v8::Local<v8::Value> jobject2v8value(jobject object);
 
+    /**
+     * convert a graph of java objects to v8 values in a single pass
+     * Maps become plain objects, Lists, Collections and Object[] become arrays; all other values are converted with jobject2v8value
+     * if the graph is too deep (e.g. because it is cyclic) an exception is thrown in v8 and an empty handle is returned
+     */
+    static v8::MaybeLocal<v8::Value> jobjectGraph2v8value(jobject object);
+
+    /**
+     * convert a graph of v8 values to java objects in a single pass
+     * plain objects become HashMaps, arrays become ArrayLists; all other values are converted with v8value2jobject
+     * if the graph is too deep (e.g. because it is cyclic) an exception is thrown in v8 and false is returned
+     */
+    static bool v8valueGraph2jobject(v8::Local<v8::Value> valueRef, jobject *result);
+
     /**
      * convert a jstring to a v8::String
      */
@@ -146,6 +172,10 @@ public:
      */
     static void registerAliasForPrimitive(jint aliasType, jint primitiveType);
 private:
+    static v8::MaybeLocal<v8::Value> jobjectGraph2v8value(JNIEnv *env, jobject object, int depth);
+    static bool v8valueGraph2jobject(JNIEnv *env, v8::Local<v8::Value> valueRef, int depth, jobject *result);
+    static bool isGraphDepthExceeded(int depth);
+
     static jobject _undefined;
     static std::unordered_map<int, JNIV8JavaValueType> _typeMap;
 
@@ -169,7 +199,30 @@ private:
     } _jniNumber;
     static struct {
         jclass clazz;
-    } _jniObject, _jniV8Object, _jniString, _jniVoid;
+    } _jniObject, _jniV8Object, _jniString, _jniVoid, _jniObjectArray;
+    static struct {
+        jclass clazz;
+        jmethodID entrySetId;
+    } _jniMap;
+    static struct {
+        jclass clazz;
+        jmethodID getKeyId;
+        jmethodID getValueId;
+    } _jniMapEntry;
+    static struct {
+        jclass clazz;
+        jmethodID toArrayId;
+    } _jniCollection;
+    static struct {
+        jclass clazz;
+        jmethodID initId;
+        jmethodID putId;
+    } _jniHashMap;
+    static struct {
+        jclass clazz;
+        jmethodID initId;
+        jmethodID addId;
+    } _jniArrayList;
 };
 
 
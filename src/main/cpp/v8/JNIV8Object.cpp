@@ -6,6 +6,9 @@
 #include "JNIV8Wrapper.h"
 #include "../bgjs/BGJSV8Engine.h"
 #include "JNIV8Function.h"
+#include "JNIV8Key.h"
+#include "JNIV8FieldSchema.h"
+#include "JNIV8Serializer.h"
 
 #include <stdlib.h>
 
@@ -55,6 +58,9 @@ void JNIV8Object::initJNICache() {
 
 JNIV8Object::JNIV8Object(jobject obj, JNIClassInfo *info) : JNIObject(obj, info) {
     _externalMemory = 0;
+    _numWrapperShares = 0;
+    _nextReleasedObject = nullptr;
+    _numPendingReleases = 0;
     // __android_log_print(ANDROID_LOG_INFO, "JNIV8Object", "created v8 object: %s", getCanonicalName().c_str());
 }
 
@@ -64,6 +70,9 @@ JNIV8Object::~JNIV8Object() {
     if(!_jsObject.IsEmpty()) {
         // adjust external memory counter if required
         JNI_ASSERT(!_jsObject.IsWeak(), "JNIV8Object deleted while still referenced by JavaScript");
+        if(_v8ClassInfo->container->type == JNIV8ObjectType::kWrapper) {
+            unlinkWrapperCache();
+        }
         _jsObject.Reset();
     }
 }
@@ -76,24 +85,20 @@ void JNIV8Object::weakPersistentCallback(const WeakCallbackInfo<void>& data) {
 
     // V8 12.4 requires that the first-pass callback resets the handle (node must be FREE).
     // Resurrection via ClearWeak() is no longer allowed in first-pass callbacks.
-    // We must Reset() here and defer cleanup to the second pass.
     jniV8Object->_jsObject.Reset();
 
-    data.SetSecondPassCallback([](const WeakCallbackInfo<void>& data) {
-        auto jniV8Object = reinterpret_cast<JNIV8Object*>(data.GetParameter());
-
-        // adjust external memory counter
-        jniV8Object->_bgjsEngine->getIsolate()->AdjustAmountOfExternalAllocatedMemory(-jniV8Object->_externalMemory);
-
-        // the js object is no longer being used => release the strong reference to the java object
-        // NOTE: object might be deleted by another thread after calling this
-        jniV8Object->releaseJObject();
-    });
+    // the js object is no longer being used => the strong reference to the java object can be released
+    // releasing requires a lock and a JNI call per object, so it is not done during GC: the object is only queued
+    // here (which does not touch v8 or JNI and is therefore allowed in the first pass), and the engine releases
+    // all queued objects in one batch
+    // until then, java can pass the object to js again; this links a new js object and retains the java object
+    // again, so if that js object is collected before the batch is processed, the object is released twice
+    jniV8Object->_bgjsEngine->enqueueObjectRelease(jniV8Object);
 }
 
 void JNIV8Object::makeWeak() {
     // wrapper type objects are not directly linked to the lifecycle of the js object
-    // they can be destroyed / gced from java at any time, and there can exist multiple
+    // they can be destroyed / gced from java at any time, and there can exist multiple; only the most recently created one is cached on the js object
     if(_v8ClassInfo->container->type == JNIV8ObjectType::kWrapper || _jsObject.IsWeak()) return;
     _jsObject.SetWeak((void*)this, JNIV8Object::weakPersistentCallback, WeakCallbackType::kParameter);
 
@@ -101,7 +106,7 @@ void JNIV8Object::makeWeak() {
     retainJObject();
 
     // object can be gc'd by v8 => adjust external memory counter
-    _bgjsEngine->getIsolate()->AdjustAmountOfExternalAllocatedMemory(_externalMemory);
+    _bgjsEngine->adjustExternalMemory(BGJSExternalMemoryType::kHeap, _externalMemory);
 }
 
 void JNIV8Object::linkJSObject(v8::Handle<v8::Object> jsObject) {
@@ -111,19 +116,41 @@ void JNIV8Object::linkJSObject(v8::Handle<v8::Object> jsObject) {
     if(_v8ClassInfo->container->type != JNIV8ObjectType::kWrapper) {
         JNI_ASSERT(jsObject->GetInternalField(0).As<v8::Value>()->IsUndefined(),"failed to link js object");
         jsObject->SetInternalField(0, External::New(isolate, (void *) this));
+    } else {
+        // wrappers are cached in a private key, so that wrapping the same object again returns this instance
+        // an existing entry is simply replaced: it belongs to a dead wrapper or to a wrapper of a different type
+        jsObject->SetPrivate(_bgjsEngine->getContext(), _bgjsEngine->getWrapperCacheKey(), External::New(isolate, (void *) this)).FromMaybe(false);
     }
 
     // store reference in persistent
     _jsObject.Reset(isolate, jsObject);
 }
 
+void JNIV8Object::unlinkWrapperCache() {
+    Isolate* isolate = _bgjsEngine->getIsolate();
+    Isolate::Scope isolateScope(isolate);
+    HandleScope scope(isolate);
+
+    Local<Context> context = _bgjsEngine->getContext();
+    if(context.IsEmpty()) return;
+
+    // only clear the cache entry if it still refers to this object; it might have been replaced by a newer wrapper
+    Local<Object> jsObject = Local<Object>::New(isolate, _jsObject);
+    Local<Private> cacheKey = _bgjsEngine->getWrapperCacheKey();
+    Local<Value> cachedValue;
+    if(jsObject->GetPrivate(context, cacheKey).ToLocal(&cachedValue) && cachedValue->IsExternal() &&
+            cachedValue.As<External>()->Value() == (void*)this) {
+        jsObject->DeletePrivate(context, cacheKey).FromMaybe(false);
+    }
+}
+
 void JNIV8Object::adjustJSExternalMemory(int64_t change) {
     _externalMemory += change;
     // external memory only counts if js object
     // - already exists
     // - is still referenced from JS
     if(!_jsObject.IsEmpty() && _jsObject.IsWeak()) {
-        _bgjsEngine->getIsolate()->AdjustAmountOfExternalAllocatedMemory(change);
+        _bgjsEngine->adjustExternalMemory(BGJSExternalMemoryType::kHeap, change);
     }
 }
 
@@ -186,19 +213,29 @@ void JNIV8Object::initializeJNIBindings(JNIClassInfo *info, bool isReload) {
     info->registerNativeMethod("Create", "(Lag/boersego/bgjs/V8Engine;Ljava/lang/String;[Ljava/lang/Object;)Lag/boersego/bgjs/JNIV8Object;", (void*)JNIV8Object::jniCreate);
 
     info->registerNativeMethod("adjustJSExternalMemory", "(J)V", (void*)JNIV8Object::jniAdjustJSExternalMemory);
+    info->registerNativeMethod("retainWrapperShare", "()V", (void*)JNIV8Object::jniRetainWrapperShare);
+    info->registerNativeMethod("releaseWrapperShare", "()Z", (void*)JNIV8Object::jniReleaseWrapperShare);
     info->registerNativeMethod("_applyV8Method", "(Ljava/lang/String;IILjava/lang/Class;[Ljava/lang/Object;)Ljava/lang/Object;", (void*)JNIV8Object::jniCallV8MethodWithReturnType);
+    info->registerNativeMethod("_applyV8Method", "(Lag/boersego/bgjs/V8Key;IILjava/lang/Class;[Ljava/lang/Object;)Ljava/lang/Object;", (void*)JNIV8Object::jniCallV8MethodWithReturnType);
     info->registerNativeMethod("_getV8Field", "(Ljava/lang/String;IILjava/lang/Class;)Ljava/lang/Object;", (void*)JNIV8Object::jniGetV8FieldWithReturnType);
+    info->registerNativeMethod("_getV8Field", "(Lag/boersego/bgjs/V8Key;IILjava/lang/Class;)Ljava/lang/Object;", (void*)JNIV8Object::jniGetV8FieldWithReturnType);
     info->registerNativeMethod("setV8Field", "(Ljava/lang/String;Ljava/lang/Object;)V", (void*)JNIV8Object::jniSetV8Field);
+    info->registerNativeMethod("setV8Field", "(Lag/boersego/bgjs/V8Key;Ljava/lang/Object;)V", (void*)JNIV8Object::jniSetV8Field);
     info->registerNativeMethod("setV8Fields", "(Ljava/util/Map;)V", (void*)JNIV8Object::jniSetV8Fields);
     info->registerNativeMethod("setV8Accessor", "(Ljava/lang/String;Lag/boersego/bgjs/JNIV8Function;Lag/boersego/bgjs/JNIV8Function;)V", (void*)JNIV8Object::jniSetV8Accessor);
 
     info->registerNativeMethod("hasV8Field", "(Ljava/lang/String;Z)Z", (void*)JNIV8Object::jniHasV8Field);
+    info->registerNativeMethod("hasV8Field", "(Lag/boersego/bgjs/V8Key;Z)Z", (void*)JNIV8Object::jniHasV8Field);
     info->registerNativeMethod("getV8Keys", "(Z)[Ljava/lang/String;", (void*)JNIV8Object::jniGetV8Keys);
     info->registerNativeMethod("getV8Fields", "(ZIILjava/lang/Class;)Ljava/util/Map;", (void*)JNIV8Object::jniGetV8Fields);
+    info->registerNativeMethod("readFields", "(Lag/boersego/bgjs/V8FieldSchema;[D)V", (void*)JNIV8Object::jniReadFields);
+    info->registerNativeMethod("writeFields", "(Lag/boersego/bgjs/V8FieldSchema;[D)V", (void*)JNIV8Object::jniWriteFields);
 
     info->registerNativeMethod("toNumber", "()D", (void*)JNIV8Object::jniToNumber);
     info->registerNativeMethod("toString", "()Ljava/lang/String;", (void*)JNIV8Object::jniToString);
     info->registerNativeMethod("toJSON", "()Ljava/lang/String;", (void*)JNIV8Object::jniToJSON);
+    info->registerNativeMethod("toJavaGraph", "()Ljava/lang/Object;", (void*)JNIV8Object::jniToJavaGraph);
+    info->registerNativeMethod("serialize", "(Ljava/util/List;)Ljava/nio/ByteBuffer;", (void*)JNIV8Object::jniSerialize);
 
     info->registerNativeMethod("isInstanceOf", "(Lag/boersego/bgjs/JNIV8Function;)Z", (void*)JNIV8Object::jniIsInstanceOfByConstructor);
     info->registerNativeMethod("isInstanceOf", "(Ljava/lang/String;)Z", (void*)JNIV8Object::jniIsInstanceOfByName);
@@ -274,12 +311,65 @@ void JNIV8Object::jniAdjustJSExternalMemory(JNIEnv *env, jobject obj, jlong chan
     ptr->adjustJSExternalMemory(change);
 }
 
-jobject JNIV8Object::jniGetV8FieldWithReturnType(JNIEnv *env, jobject obj, jstring name, jint flags, jint type, jclass returnType) {
+void JNIV8Object::jniRetainWrapperShare(JNIEnv *env, jobject obj) {
+    auto ptr = JNIWrapper::wrapObject<JNIV8Object>(obj);
+    if(!ptr) {
+        env->ThrowNew(env->FindClass("java/lang/RuntimeException"), "Attempt to call method on disposed object");
+        return;
+    }
+    // only wrappers are shared; all other objects are disposed by their single owner
+    if(ptr->_v8ClassInfo->container->type != JNIV8ObjectType::kWrapper) return;
+
+    V8Locker l(ptr->_bgjsEngine->getIsolate(), __FUNCTION__);
+    ptr->_numWrapperShares++;
+}
+
+jboolean JNIV8Object::jniReleaseWrapperShare(JNIEnv *env, jobject obj) {
+    auto ptr = JNIWrapper::wrapObject<JNIV8Object>(obj);
+    if(!ptr || ptr->_v8ClassInfo->container->type != JNIV8ObjectType::kWrapper) {
+        return (jboolean)true;
+    }
+
+    // shares are only taken explicitly from java via retain(); objects handed out by native code do not take one.
+    // Without outstanding shares, dispose() disposes right away. The cache entry is removed under the lock, so the
+    // wrapper can not be handed out again while it is disposed
+    V8Locker l(ptr->_bgjsEngine->getIsolate(), __FUNCTION__);
+    if(ptr->_numWrapperShares > 0 && --ptr->_numWrapperShares > 0) {
+        return (jboolean)false;
+    }
+    ptr->unlinkWrapperCache();
+    return (jboolean)true;
+}
+
+/**
+ * converts a property name passed from java to a v8 string
+ * V8Keys already hold an internalized string, so no conversion is required for them
+ * returns an empty handle and throws a java exception if the key is invalid
+ */
+v8::Local<v8::String> JNIV8Object::getPropertyKey(JNIEnv *env, BGJSV8Engine *engine, jobject name) {
+    if(!name || env->IsInstanceOf(name, _jniString.clazz)) {
+        return JNIV8Marshalling::jstring2v8string((jstring)name);
+    }
+    auto key = JNIWrapper::wrapObject<JNIV8Key>(name);
+    if(!key || key->getEngine() != engine) {
+        env->ThrowNew(env->FindClass("java/lang/IllegalArgumentException"),
+                      "V8Key was created for a different engine");
+        return v8::Local<v8::String>();
+    }
+    return key->getV8String(engine->getIsolate());
+}
+
+jobject JNIV8Object::jniGetV8FieldWithReturnType(JNIEnv *env, jobject obj, jobject name, jint flags, jint type, jclass returnType) {
     JNIV8Object_PrepareJNICall(JNIV8Object, Object, nullptr);
 
     JNIV8JavaValue arg = JNIV8Marshalling::valueWithClass(type, returnType, (JNIV8MarshallingFlags)flags);
 
-    MaybeLocal<Value> valueRef = localRef->Get(context, JNIV8Marshalling::jstring2v8string(name));
+    Local<String> keyRef = getPropertyKey(env, engine, name);
+    if(keyRef.IsEmpty()) {
+        return nullptr;
+    }
+
+    MaybeLocal<Value> valueRef = localRef->Get(context, keyRef);
     if(valueRef.IsEmpty()) {
         ptr->getEngine()->forwardV8ExceptionToJNI(&try_catch);
         return nullptr;
@@ -289,7 +379,7 @@ jobject JNIV8Object::jniGetV8FieldWithReturnType(JNIEnv *env, jobject obj, jstri
     memset(&jval, 0, sizeof(jvalue));
     JNIV8MarshallingError res = JNIV8Marshalling::convertV8ValueToJavaValue(env, valueRef.ToLocalChecked(), arg, &jval);
     if(res != JNIV8MarshallingError::kOk) {
-        std::string strFieldName = JNIWrapper::jstring2string(name);
+        std::string strFieldName = JNIV8Marshalling::v8string2string(keyRef);
         switch(res) {
             default:
             case JNIV8MarshallingError::kWrongType:
@@ -318,10 +408,15 @@ jobject JNIV8Object::jniGetV8FieldWithReturnType(JNIEnv *env, jobject obj, jstri
     return jval.l;
 }
 
-void JNIV8Object::jniSetV8Field(JNIEnv *env, jobject obj, jstring name, jobject value) {
+void JNIV8Object::jniSetV8Field(JNIEnv *env, jobject obj, jobject name, jobject value) {
     JNIV8Object_PrepareJNICall(JNIV8Object, Object, void());
 
-    Maybe<bool> res = localRef->Set(context, JNIV8Marshalling::jstring2v8string(name), JNIV8Marshalling::jobject2v8value(value));
+    Local<String> keyRef = getPropertyKey(env, engine, name);
+    if(keyRef.IsEmpty()) {
+        return;
+    }
+
+    Maybe<bool> res = localRef->Set(context, keyRef, JNIV8Marshalling::jobject2v8value(value));
     if(res.IsNothing()) {
         ptr->getEngine()->forwardV8ExceptionToJNI(&try_catch);
     }
@@ -373,14 +468,19 @@ void JNIV8Object::jniSetV8Accessor(JNIEnv *env, jobject obj, jstring name, jobje
     );
 }
 
-jobject JNIV8Object::jniCallV8MethodWithReturnType(JNIEnv *env, jobject obj, jstring name, jint flags, jint type, jclass returnType, jobjectArray arguments) {
+jobject JNIV8Object::jniCallV8MethodWithReturnType(JNIEnv *env, jobject obj, jobject name, jint flags, jint type, jclass returnType, jobjectArray arguments) {
     JNIV8Object_PrepareJNICall(JNIV8Object, Object, nullptr);
 
     JNIV8JavaValue arg = JNIV8Marshalling::valueWithClass(type, returnType, (JNIV8MarshallingFlags)flags);
 
+    Local<String> keyRef = getPropertyKey(env, engine, name);
+    if(keyRef.IsEmpty()) {
+        return nullptr;
+    }
+
     MaybeLocal<Value> maybeLocal;
     Local<Value> funcRef;
-    maybeLocal = localRef->Get(context, JNIV8Marshalling::jstring2v8string(name));
+    maybeLocal = localRef->Get(context, keyRef);
     if (!maybeLocal.ToLocal<Value>(&funcRef)) {
         ptr->getEngine()->forwardV8ExceptionToJNI(&try_catch);
         return nullptr;
@@ -422,7 +522,7 @@ jobject JNIV8Object::jniCallV8MethodWithReturnType(JNIEnv *env, jobject obj, jst
     memset(&jval, 0, sizeof(jvalue));
     JNIV8MarshallingError res = JNIV8Marshalling::convertV8ValueToJavaValue(env, resultRef, arg, &jval);
     if(res != JNIV8MarshallingError::kOk) {
-        std::string strMethodName = JNIWrapper::jstring2string(name);
+        std::string strMethodName = JNIV8Marshalling::v8string2string(keyRef);
         switch(res) {
             default:
             case JNIV8MarshallingError::kWrongType:
@@ -451,10 +551,13 @@ jobject JNIV8Object::jniCallV8MethodWithReturnType(JNIEnv *env, jobject obj, jst
     return jval.l;
 }
 
-jboolean JNIV8Object::jniHasV8Field(JNIEnv *env, jobject obj, jstring name, jboolean ownOnly) {
+jboolean JNIV8Object::jniHasV8Field(JNIEnv *env, jobject obj, jobject name, jboolean ownOnly) {
     JNIV8Object_PrepareJNICall(JNIV8Object, Object, false);
 
-    Local<String> keyRef = JNIV8Marshalling::jstring2v8string(name);
+    Local<String> keyRef = getPropertyKey(env, engine, name);
+    if(keyRef.IsEmpty()) {
+        return (jboolean)false;
+    }
     Maybe<bool> res = ownOnly ? localRef->HasOwnProperty(context, keyRef) : localRef->Has(context, keyRef);
     if(res.IsNothing()) {
         ptr->getEngine()->forwardV8ExceptionToJNI(&try_catch);
@@ -574,6 +677,47 @@ jobject JNIV8Object::jniGetV8Fields(JNIEnv *env, jobject obj, jboolean ownOnly,
     return result;
 }
 
+void JNIV8Object::jniReadFields(JNIEnv *env, jobject obj, jobject schemaObj, jdoubleArray target) {
+    JNIV8Object_PrepareJNICall(JNIV8Object, Object, void());
+
+    auto schema = JNIV8FieldSchema::wrapForEngine(env, schemaObj, engine);
+    if(!schema) return;
+
+    const size_t numFields = schema->getFieldCount();
+    if(!target || (size_t)env->GetArrayLength(target) < numFields) {
+        env->ThrowNew(env->FindClass("java/lang/IndexOutOfBoundsException"),
+                      "Target array is too small for schema");
+        return;
+    }
+
+    std::vector<jdouble> values(numFields);
+    if(!schema->readFields(context, localRef, values.data())) {
+        engine->forwardV8ExceptionToJNI(&try_catch);
+        return;
+    }
+    env->SetDoubleArrayRegion(target, 0, (jsize)numFields, values.data());
+}
+
+void JNIV8Object::jniWriteFields(JNIEnv *env, jobject obj, jobject schemaObj, jdoubleArray source) {
+    JNIV8Object_PrepareJNICall(JNIV8Object, Object, void());
+
+    auto schema = JNIV8FieldSchema::wrapForEngine(env, schemaObj, engine);
+    if(!schema) return;
+
+    const size_t numFields = schema->getFieldCount();
+    if(!source || (size_t)env->GetArrayLength(source) < numFields) {
+        env->ThrowNew(env->FindClass("java/lang/IndexOutOfBoundsException"),
+                      "Source array is too small for schema");
+        return;
+    }
+
+    std::vector<jdouble> values(numFields);
+    env->GetDoubleArrayRegion(source, 0, (jsize)numFields, values.data());
+    if(!schema->writeFields(context, localRef, values.data())) {
+        engine->forwardV8ExceptionToJNI(&try_catch);
+    }
+}
+
 jdouble JNIV8Object::jniToNumber(JNIEnv *env, jobject obj) {
     JNIV8Object_PrepareJNICall(JNIV8Object, Object, 0);
     v8::Maybe<double> numberValue = localRef->NumberValue(context);
@@ -594,6 +738,26 @@ jstring JNIV8Object::jniToJSON(JNIEnv *env, jobject obj) {
     return JNIV8Marshalling::v8string2jstring(stringValue.ToLocalChecked().As<v8::String>());
 }
 
+jobject JNIV8Object::jniToJavaGraph(JNIEnv *env, jobject obj) {
+    JNIV8Object_PrepareJNICall(JNIV8Object, Object, nullptr);
+    jobject result;
+    if (!JNIV8Marshalling::v8valueGraph2jobject(localRef, &result)) {
+        engine->forwardV8ExceptionToJNI(&try_catch);
+        return nullptr;
+    }
+    return result;
+}
+
+jobject JNIV8Object::jniSerialize(JNIEnv *env, jobject obj, jobject hostObjects) {
+    JNIV8Object_PrepareJNICall(JNIV8Object, Object, nullptr);
+    jobject result = JNIV8Serializer::serialize(context, localRef, hostObjects);
+    if (!result) {
+        engine->forwardV8ExceptionToJNI(&try_catch);
+        return nullptr;
+    }
+    return result;
+}
+
 jstring JNIV8Object::jniToString(JNIEnv *env, jobject obj) {
     JNIV8Object_PrepareJNICall(JNIV8Object, Object, nullptr);
     MaybeLocal<String> maybeLocal = localRef->ToString(context);
@@ -7,6 +7,7 @@
 
 #include "JNIV8ClassInfo.h"
 #include <jni.h>
+#include <atomic>
 #include "../jni/jni.h"
 
 class BGJSV8Engine;
@@ -17,12 +18,10 @@ auto ptr = JNIWrapper::wrapObject<T>(obj);\
 if(!ptr){env->ThrowNew(env->FindClass("java/lang/RuntimeException"), "Attempt to call method on disposed object"); return R;}\
 BGJSV8Engine *engine = ptr->getEngine();\
 v8::Isolate* isolate = engine->getIsolate();\
-V8Locker l(isolate, __FUNCTION__);\
-v8::Isolate::Scope isolateScope(isolate);\
+V8Session session(engine, __FUNCTION__);\
 v8::HandleScope scope(isolate);\
 v8::Local<v8::Context> context = engine->getContext();\
 v8::Context::Scope ctxScope(context);\
-v8::MicrotasksScope taskScope(isolate, v8::MicrotasksScope::kRunMicrotasks);\
 v8::TryCatch try_catch(isolate);\
 v8::Local<L> localRef = v8::Local<v8::Object>::New(isolate, ptr->getJSObject()).As<L>();
 
@@ -47,6 +46,7 @@ env->ThrowNew(env->FindClass("java/lang/ClassCastException"), (msg).c_str());
 class JNIV8Object : public JNIObject {
     friend class JNIV8Wrapper;
     friend class JNIWrapper;
+    friend class BGJSV8Engine;
 public:
     JNIV8Object(jobject obj, JNIClassInfo *info);
     virtual ~JNIV8Object();
@@ -77,6 +77,7 @@ private:
     // private methods
     void makeWeak();
     void linkJSObject(v8::Handle<v8::Object> jsObject);
+    void unlinkWrapperCache();
 
     // initialization; called from JNIV8Wrapper
     void setJSObject(BGJSV8Engine *engine, JNIV8ClassInfo *cls, v8::Handle<v8::Object> jsObject);
@@ -87,22 +88,31 @@ private:
     // jni callbacks
     static jobject jniCreate(JNIEnv *env, jobject obj, jobject engine, jstring name, jobjectArray arguments);
     static void jniAdjustJSExternalMemory(JNIEnv *env, jobject obj, jlong change);
-    static jobject jniGetV8FieldWithReturnType(JNIEnv *env, jobject obj, jstring name, jint flags, jint type, jclass returnType);
-    static void jniSetV8Field(JNIEnv *env, jobject obj, jstring name, jobject value);
+    static void jniRetainWrapperShare(JNIEnv *env, jobject obj);
+    static jboolean jniReleaseWrapperShare(JNIEnv *env, jobject obj);
+    static jobject jniGetV8FieldWithReturnType(JNIEnv *env, jobject obj, jobject name, jint flags, jint type, jclass returnType);
+    static void jniSetV8Field(JNIEnv *env, jobject obj, jobject name, jobject value);
     static void jniSetV8Fields(JNIEnv *env, jobject obj, jobject map);
     static void jniSetV8Accessor(JNIEnv *env, jobject obj, jstring name, jobject getter, jobject setter);
-    static jobject jniCallV8MethodWithReturnType(JNIEnv *env, jobject obj, jstring name, jint flags, jint type, jclass returnType, jobjectArray arguments);
-    static jboolean jniHasV8Field(JNIEnv *env, jobject obj, jstring name, jboolean ownOnly);
+    static jobject jniCallV8MethodWithReturnType(JNIEnv *env, jobject obj, jobject name, jint flags, jint type, jclass returnType, jobjectArray arguments);
+    static jboolean jniHasV8Field(JNIEnv *env, jobject obj, jobject name, jboolean ownOnly);
     static jobjectArray jniGetV8Keys(JNIEnv *env, jobject obj, jboolean ownOnly);
     static jobject jniGetV8Fields(JNIEnv *env, jobject obj, jboolean ownOnly, jint flags, jint type, jclass returnType);
+    static void jniReadFields(JNIEnv *env, jobject obj, jobject schema, jdoubleArray target);
+    static void jniWriteFields(JNIEnv *env, jobject obj, jobject schema, jdoubleArray source);
     static jdouble jniToNumber(JNIEnv *env, jobject obj);
     static jstring jniToString(JNIEnv *env, jobject obj);
     static jstring jniToJSON(JNIEnv *env, jobject obj);
+    static jobject jniToJavaGraph(JNIEnv *env, jobject obj);
+    static jobject jniSerialize(JNIEnv *env, jobject obj, jobject hostObjects);
     static jboolean jniIsInstanceOfByConstructor(JNIEnv *env, jobject obj, jobject constructor);
     static jboolean jniIsInstanceOfByName(JNIEnv *env, jobject obj, jstring name);
     static void jniRegisterV8Class(JNIEnv *env, jobject obj, jstring derivedClass, jstring baseClass);
     static void jniRegisterAliasForPrimitive(JNIEnv *env, jobject obj, jint aliasType, jint primitiveType);
 
+    // converts a property name passed from java (either a String or a V8Key) to a v8 string
+    static v8::Local<v8::String> getPropertyKey(JNIEnv *env, BGJSV8Engine *engine, jobject name);
+
     // v8 callbacks
     static void weakPersistentCallback(const v8::WeakCallbackInfo<void>& data);
 
@@ -138,9 +148,15 @@ private:
     } _jniHashMap;
     // private properties
     int64_t _externalMemory;
+    // number of shares taken on a cached wrapper via retain(); only accessed while holding the isolate lock
+    int _numWrapperShares;
     JNIV8ClassInfo *_v8ClassInfo;
     BGJSV8Engine *_bgjsEngine;
     v8::Persistent<v8::Object> _jsObject;
+    // link in the list of objects collected by v8 that are waiting for their java object to be released
+    JNIV8Object *_nextReleasedObject;
+    // number of collected js objects whose release is still pending; the object is linked while this is not 0
+    std::atomic<int> _numPendingReleases;
 };
 
 BGJS_JNI_LINK_DEF(JNIV8Object)
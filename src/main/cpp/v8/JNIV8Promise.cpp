@@ -9,10 +9,41 @@
 BGJS_JNI_LINK(JNIV8Promise, "ag/boersego/bgjs/JNIV8Promise");
 BGJS_JNI_LINK(JNIV8PromiseResolver, "ag/boersego/bgjs/JNIV8Promise$Resolver");
 
+decltype(JNIV8Promise::_jniCompletableFuture) JNIV8Promise::_jniCompletableFuture = {0};
+decltype(JNIV8Promise::_jniCompletionStage) JNIV8Promise::_jniCompletionStage = {0};
+decltype(JNIV8PromiseResolver::_jniThrowable) JNIV8PromiseResolver::_jniThrowable = {0};
+
+/**
+ * holds the future returned by JNIV8Promise.toFuture until the promise is settled or collected
+ */
+struct JNIV8PromiseFutureHolder {
+    jobject future;
+    v8::Persistent<v8::Function> callback;
+};
+
+static void JNIV8PromiseFutureHolderWeakCallback(const v8::WeakCallbackInfo<JNIV8PromiseFutureHolder> &data) {
+    JNIV8PromiseFutureHolder *holder = data.GetParameter();
+    holder->callback.Reset();
+    if (holder->future) {
+        JNIWrapper::getEnvironment()->DeleteGlobalRef(holder->future);
+    }
+    delete holder;
+}
+
 /**
  * cache JNI class references
  */
 void JNIV8Promise::initJNICache() {
+    JNIEnv *env = JNIWrapper::getEnvironment();
+
+    _jniCompletableFuture.clazz = (jclass)env->NewGlobalRef(env->FindClass("java/util/concurrent/CompletableFuture"));
+    _jniCompletableFuture.initId = env->GetMethodID(_jniCompletableFuture.clazz, "<init>", "()V");
+    _jniCompletableFuture.completeId = env->GetMethodID(_jniCompletableFuture.clazz, "complete", "(Ljava/lang/Object;)Z");
+    _jniCompletableFuture.completeExceptionallyId = env->GetMethodID(_jniCompletableFuture.clazz, "completeExceptionally", "(Ljava/lang/Throwable;)Z");
+
+    _jniCompletionStage.clazz = (jclass)env->NewGlobalRef(env->FindClass("java/util/concurrent/CompletionStage"));
+    _jniCompletionStage.whenCompleteId = env->GetMethodID(_jniCompletionStage.clazz, "whenComplete",
+                                                          "(Ljava/util/function/BiConsumer;)Ljava/util/concurrent/CompletionStage;");
 }
 
 bool JNIV8Promise::isWrappableV8Object(v8::Local<v8::Object> object) {
@@ -21,6 +52,8 @@ bool JNIV8Promise::isWrappableV8Object(v8::Local<v8::Object> object) {
 
 void JNIV8Promise::initializeJNIBindings(JNIClassInfo *info, bool isReload) {
     info->registerNativeMethod("CreateResolver", "(Lag/boersego/bgjs/V8Engine;)Lag/boersego/bgjs/JNIV8Promise$Resolver;", (void*)JNIV8Promise::jniCreateResolver);
+    info->registerNativeMethod("FromFuture", "(Lag/boersego/bgjs/V8Engine;Ljava/util/concurrent/CompletionStage;)Lag/boersego/bgjs/JNIV8Promise;", (void*)JNIV8Promise::jniFromFuture);
+    info->registerNativeMethod("toFuture", "()Ljava/util/concurrent/CompletableFuture;", (void*)JNIV8Promise::jniToFuture);
 }
 
 jobject JNIV8Promise::jniCreateResolver(JNIEnv *env, jobject obj, jobject engineObj) {
@@ -50,6 +83,109 @@ jobject JNIV8Promise::jniCreateResolver(JNIEnv *env, jobject obj, jobject engine
     return JNIV8Wrapper::wrapObject<JNIV8PromiseResolver>(resolverRef)->getJObject();
 }
 
+jobject JNIV8Promise::jniFromFuture(JNIEnv *env, jobject obj, jobject engineObj, jobject future) {
+    jobject resolver = jniCreateResolver(env, obj, engineObj);
+    if (!resolver) {
+        return nullptr;
+    }
+    jobject promise = JNIV8PromiseResolver::jniGetPromise(env, resolver);
+
+    // the resolver itself is the completion handler; it settles the promise asynchronously, so the stage can be
+    // completed on any thread without locking the isolate
+    jobject stage = env->CallObjectMethod(future, _jniCompletionStage.whenCompleteId, resolver);
+    if (stage) {
+        env->DeleteLocalRef(stage);
+    }
+    env->DeleteLocalRef(resolver);
+
+    return promise;
+}
+
+jobject JNIV8Promise::jniToFuture(JNIEnv *env, jobject obj) {
+    JNIV8Object_PrepareJNICall(JNIV8Promise, v8::Promise, nullptr);
+
+    jobject future = env->NewObject(_jniCompletableFuture.clazz, _jniCompletableFuture.initId);
+
+    auto *holder = new JNIV8PromiseFutureHolder();
+    holder->future = env->NewGlobalRef(future);
+    v8::Local<v8::External> data = v8::External::New(isolate, holder);
+
+    v8::Local<v8::Function> fulfilledRef, rejectedRef;
+    if (!v8::Function::New(context, v8FutureFulfilledCallback, data, 1, v8::ConstructorBehavior::kThrow).ToLocal(&fulfilledRef) ||
+        !v8::Function::New(context, v8FutureRejectedCallback, data, 1, v8::ConstructorBehavior::kThrow).ToLocal(&rejectedRef)) {
+        env->DeleteGlobalRef(holder->future);
+        delete holder;
+        engine->forwardV8ExceptionToJNI(&try_catch);
+        return nullptr;
+    }
+
+    // both callbacks are referenced by the same reaction; once it is gone, neither of them can be called anymore
+    holder->callback.Reset(isolate, fulfilledRef);
+    holder->callback.SetWeak(holder, JNIV8PromiseFutureHolderWeakCallback, v8::WeakCallbackType::kParameter);
+
+    v8::Local<v8::Promise> resultRef;
+    if (!localRef->Then(context, fulfilledRef, rejectedRef).ToLocal(&resultRef)) {
+        engine->forwardV8ExceptionToJNI(&try_catch);
+        return nullptr;
+    }
+
+    return future;
+}
+
+void JNIV8Promise::v8FutureFulfilledCallback(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto *holder = static_cast<JNIV8PromiseFutureHolder*>(args.Data().As<v8::External>()->Value());
+    if (!holder->future) return;
+
+    JNIEnv *env = JNIWrapper::getEnvironment();
+    jobject value = JNIV8Marshalling::v8value2jobject(args[0]);
+    env->CallBooleanMethod(holder->future, _jniCompletableFuture.completeId, value);
+    env->DeleteLocalRef(value);
+
+    env->DeleteGlobalRef(holder->future);
+    holder->future = nullptr;
+
+    BGJSV8Engine::GetInstance(args.GetIsolate())->forwardJNIExceptionToV8();
+}
+
+void JNIV8Promise::v8FutureRejectedCallback(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    auto *holder = static_cast<JNIV8PromiseFutureHolder*>(args.Data().As<v8::External>()->Value());
+    if (!holder->future) return;
+
+    v8::Isolate *isolate = args.GetIsolate();
+    BGJSV8Engine *engine = BGJSV8Engine::GetInstance(isolate);
+    JNIEnv *env = JNIWrapper::getEnvironment();
+
+    // convert the reason the same way as an exception raised by js code called from java
+    {
+        v8::TryCatch try_catch(isolate);
+        isolate->ThrowException(args[0]);
+        engine->forwardV8ExceptionToJNI(&try_catch, false);
+    }
+    jthrowable throwable = env->ExceptionOccurred();
+    env->ExceptionClear();
+
+    // completeExceptionally does not accept null; if the reason could not be converted, wrap its string representation
+    if (!throwable) {
+        std::string message = "Promise rejected";
+        v8::TryCatch try_catch(isolate);
+        v8::Local<v8::String> reasonRef;
+        if (args[0]->ToString(isolate->GetCurrentContext()).ToLocal(&reasonRef)) {
+            message += ": " + JNIV8Marshalling::v8string2string(reasonRef);
+        }
+        env->ThrowNew(env->FindClass("java/lang/RuntimeException"), message.c_str());
+        throwable = env->ExceptionOccurred();
+        env->ExceptionClear();
+    }
+
+    env->CallBooleanMethod(holder->future, _jniCompletableFuture.completeExceptionallyId, throwable);
+    env->DeleteLocalRef(throwable);
+
+    env->DeleteGlobalRef(holder->future);
+    holder->future = nullptr;
+
+    engine->forwardJNIExceptionToV8();
+}
+
 void JNIV8Promise::OnJSObjectAssigned() {
     BGJSV8Engine *engine = getEngine();
     v8::Isolate *isolate = engine->getIsolate();
@@ -70,6 +206,9 @@ void JNIV8Promise::OnJSObjectAssigned() {
  * cache JNI class references
  */
 void JNIV8PromiseResolver::initJNICache() {
+    JNIEnv *env = JNIWrapper::getEnvironment();
+
+    _jniThrowable.clazz = (jclass)env->NewGlobalRef(env->FindClass("java/lang/Throwable"));
 }
 
 bool JNIV8PromiseResolver::isWrappableV8Object(v8::Local<v8::Object> object) {
@@ -86,6 +225,8 @@ void JNIV8PromiseResolver::initializeJNIBindings(JNIClassInfo *info, bool isRelo
     info->registerNativeMethod("getPromise", "()Lag/boersego/bgjs/JNIV8Promise;", (void*)JNIV8PromiseResolver::jniGetPromise);
     info->registerNativeMethod("resolve", "(Ljava/lang/Object;)Z", (void*)JNIV8PromiseResolver::jniResolve);
     info->registerNativeMethod("reject", "(Ljava/lang/Object;)Z", (void*)JNIV8PromiseResolver::jniReject);
+    info->registerNativeMethod("resolveAsync", "(Ljava/lang/Object;)V", (void*)JNIV8PromiseResolver::jniResolveAsync);
+    info->registerNativeMethod("rejectAsync", "(Ljava/lang/Object;)V", (void*)JNIV8PromiseResolver::jniRejectAsync);
 }
 
 jobject JNIV8PromiseResolver::jniGetPromise(JNIEnv *env, jobject obj) {
@@ -116,4 +257,50 @@ jboolean JNIV8PromiseResolver::jniReject(JNIEnv *env, jobject obj, jobject value
     }
 
     return (jboolean)result.FromJust();
-}
\ No newline at end of file
+}
+
+void JNIV8PromiseResolver::jniResolveAsync(JNIEnv *env, jobject obj, jobject value) {
+    auto ptr = JNIWrapper::wrapObject<JNIV8PromiseResolver>(obj);
+    if(!ptr){env->ThrowNew(env->FindClass("java/lang/RuntimeException"), "Attempt to call method on disposed object"); return;}
+
+    ptr->getEngine()->enqueuePromiseSettlement(obj, value, false);
+}
+
+void JNIV8PromiseResolver::jniRejectAsync(JNIEnv *env, jobject obj, jobject value) {
+    auto ptr = JNIWrapper::wrapObject<JNIV8PromiseResolver>(obj);
+    if(!ptr){env->ThrowNew(env->FindClass("java/lang/RuntimeException"), "Attempt to call method on disposed object"); return;}
+
+    ptr->getEngine()->enqueuePromiseSettlement(obj, value, true);
+}
+
+bool JNIV8PromiseResolver::settle(jobject resolver, jobject value, bool reject) {
+    auto ptr = JNIWrapper::wrapObject<JNIV8PromiseResolver>(resolver);
+    if (!ptr) {
+        // the resolver was disposed while the settlement was queued
+        v8::Isolate* currentIsolate = v8::Isolate::GetCurrent();
+        currentIsolate->ThrowException(v8::Exception::Error(
+                v8::String::NewFromUtf8(currentIsolate, "Attempt to settle a disposed promise resolver").ToLocalChecked()));
+        return false;
+    }
+    BGJSV8Engine *engine = ptr->getEngine();
+    v8::Isolate* isolate = engine->getIsolate();
+    v8::Local<v8::Context> context = engine->getContext();
+    v8::Local<v8::Promise::Resolver> resolverRef = ptr->getJSObject().As<v8::Promise::Resolver>();
+
+    if (!reject) {
+        return resolverRef->Resolve(context, JNIV8Marshalling::jobject2v8value(value)).IsJust();
+    }
+
+    v8::Local<v8::Value> reasonRef;
+    JNIEnv *env = JNIWrapper::getEnvironment();
+    if (value && env->IsInstanceOf(value, _jniThrowable.clazz)) {
+        // convert the exception the same way as an exception raised by java code called from js
+        v8::TryCatch try_catch(isolate);
+        env->Throw((jthrowable)value);
+        engine->forwardJNIExceptionToV8();
+        reasonRef = try_catch.Exception();
+    } else {
+        reasonRef = JNIV8Marshalling::jobject2v8value(value);
+    }
+    return resolverRef->Reject(context, reasonRef).IsJust();
+}
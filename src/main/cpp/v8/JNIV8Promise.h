@@ -15,6 +15,8 @@ public:
     static void initializeJNIBindings(JNIClassInfo *info, bool isReload);
 
     static jobject jniCreateResolver(JNIEnv *env, jobject obj, jobject engineObj);
+    static jobject jniFromFuture(JNIEnv *env, jobject obj, jobject engineObj, jobject future);
+    static jobject jniToFuture(JNIEnv *env, jobject obj);
 
     /**
      * cache JNI class references
@@ -23,6 +25,21 @@ public:
 
 protected:
     void OnJSObjectAssigned();
+
+private:
+    static void v8FutureFulfilledCallback(const v8::FunctionCallbackInfo<v8::Value>& args);
+    static void v8FutureRejectedCallback(const v8::FunctionCallbackInfo<v8::Value>& args);
+
+    static struct {
+        jclass clazz;
+        jmethodID initId;
+        jmethodID completeId;
+        jmethodID completeExceptionallyId;
+    } _jniCompletableFuture;
+    static struct {
+        jclass clazz;
+        jmethodID whenCompleteId;
+    } _jniCompletionStage;
 };
 
 BGJS_JNI_LINK_DEF(JNIV8Promise)
@@ -37,11 +54,26 @@ public:
     static jobject jniGetPromise(JNIEnv *env, jobject obj);
     static jboolean jniResolve(JNIEnv *env, jobject obj, jobject value);
     static jboolean jniReject(JNIEnv *env, jobject obj, jobject value);
+    static void jniResolveAsync(JNIEnv *env, jobject obj, jobject value);
+    static void jniRejectAsync(JNIEnv *env, jobject obj, jobject value);
+
+    /**
+     * resolves or rejects the promise of the specified resolver
+     * java exceptions used as rejection value are converted to js errors
+     * must be called with the isolate locked and the context entered
+     * returns false if a js exception was raised
+     */
+    static bool settle(jobject resolver, jobject value, bool reject);
 
     /**
      * cache JNI class references
      */
     static void initJNICache();
+
+private:
+    static struct {
+        jclass clazz;
+    } _jniThrowable;
 };
 
 BGJS_JNI_LINK_DEF(JNIV8PromiseResolver)
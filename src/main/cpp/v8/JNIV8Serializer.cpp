@@ -0,0 +1,134 @@
+//
+// Created on 19.10.26.
+//
+
+#include "JNIV8Serializer.h"
+
+#include <cstring>
+
+decltype(JNIV8Serializer::_jniByteBuffer) JNIV8Serializer::_jniByteBuffer = {0};
+decltype(JNIV8Serializer::_jniList) JNIV8Serializer::_jniList = {0};
+
+/**
+ * writes js objects backed by java objects as an index into the host object list
+ */
+class JNIV8Serializer::SerializerDelegate : public v8::ValueSerializer::Delegate {
+public:
+    SerializerDelegate(v8::Isolate *isolate, jobject hostObjects) : serializer(nullptr), _isolate(isolate), _hostObjects(hostObjects) {}
+
+    void ThrowDataCloneError(v8::Local<v8::String> message) override {
+        _isolate->ThrowException(v8::Exception::Error(message));
+    }
+
+    v8::Maybe<bool> WriteHostObject(v8::Isolate *isolate, v8::Local<v8::Object> object) override {
+        JNIEnv *env = JNIWrapper::getEnvironment();
+
+        auto ptr = JNIV8Wrapper::wrapObject<JNIV8Object>(object);
+        if (!ptr || !_hostObjects) {
+            ThrowDataCloneError(v8::String::NewFromUtf8Literal(isolate, "object is backed by a native object and can not be serialized without a host object list"));
+            return v8::Nothing<bool>();
+        }
+
+        jint index = env->CallIntMethod(_hostObjects, _jniList.sizeId);
+        env->CallBooleanMethod(_hostObjects, _jniList.addId, ptr->getJObject());
+        if (env->ExceptionCheck()) {
+            BGJSV8Engine::GetInstance(isolate)->forwardJNIExceptionToV8();
+            return v8::Nothing<bool>();
+        }
+        serializer->WriteUint32((uint32_t)index);
+        return v8::Just(true);
+    }
+
+    v8::ValueSerializer *serializer;
+private:
+    v8::Isolate *_isolate;
+    jobject _hostObjects;
+};
+
+/**
+ * resolves host object indices written by SerializerDelegate
+ */
+class JNIV8Serializer::DeserializerDelegate : public v8::ValueDeserializer::Delegate {
+public:
+    explicit DeserializerDelegate(jobjectArray hostObjects) : deserializer(nullptr), _hostObjects(hostObjects) {}
+
+    v8::MaybeLocal<v8::Object> ReadHostObject(v8::Isolate *isolate) override {
+        JNIEnv *env = JNIWrapper::getEnvironment();
+
+        uint32_t index;
+        if (!deserializer->ReadUint32(&index) || !_hostObjects || index >= (uint32_t)env->GetArrayLength(_hostObjects)) {
+            isolate->ThrowException(v8::Exception::Error(v8::String::NewFromUtf8Literal(isolate, "invalid host object reference")));
+            return v8::MaybeLocal<v8::Object>();
+        }
+
+        jobject hostObject = env->GetObjectArrayElement(_hostObjects, (jsize)index);
+        v8::Local<v8::Value> valueRef = JNIV8Marshalling::jobject2v8value(hostObject);
+        env->DeleteLocalRef(hostObject);
+        if (!valueRef->IsObject()) {
+            isolate->ThrowException(v8::Exception::Error(v8::String::NewFromUtf8Literal(isolate, "host object reference does not resolve to a JNIV8Object")));
+            return v8::MaybeLocal<v8::Object>();
+        }
+        return valueRef.As<v8::Object>();
+    }
+
+    v8::ValueDeserializer *deserializer;
+private:
+    jobjectArray _hostObjects;
+};
+
+/**
+ * cache JNI class references
+ */
+void JNIV8Serializer::initJNICache() {
+    JNIEnv *env = JNIWrapper::getEnvironment();
+
+    _jniByteBuffer.clazz = (jclass)env->NewGlobalRef(env->FindClass("java/nio/ByteBuffer"));
+    _jniByteBuffer.allocateDirectId = env->GetStaticMethodID(_jniByteBuffer.clazz, "allocateDirect", "(I)Ljava/nio/ByteBuffer;");
+
+    _jniList.clazz = (jclass)env->NewGlobalRef(env->FindClass("java/util/List"));
+    _jniList.sizeId = env->GetMethodID(_jniList.clazz, "size", "()I");
+    _jniList.addId = env->GetMethodID(_jniList.clazz, "add", "(Ljava/lang/Object;)Z");
+}
+
+jobject JNIV8Serializer::serialize(v8::Local<v8::Context> context, v8::Local<v8::Value> value, jobject hostObjects) {
+    JNIEnv *env = JNIWrapper::getEnvironment();
+    v8::Isolate *isolate = context->GetIsolate();
+
+    SerializerDelegate delegate(isolate, hostObjects);
+    v8::ValueSerializer serializer(isolate, &delegate);
+    delegate.serializer = &serializer;
+
+    serializer.WriteHeader();
+    if (serializer.WriteValue(context, value).IsNothing()) {
+        return nullptr;
+    }
+
+    // the serializer buffer is copied once into the direct buffer that is handed to java
+    std::pair<uint8_t*, size_t> buffer = serializer.Release();
+    jobject byteBuffer = env->CallStaticObjectMethod(_jniByteBuffer.clazz, _jniByteBuffer.allocateDirectId, (jint)buffer.second);
+    if (byteBuffer) {
+        memcpy(env->GetDirectBufferAddress(byteBuffer), buffer.first, buffer.second);
+    }
+    delegate.FreeBufferMemory(buffer.first);
+
+    if (env->ExceptionCheck()) {
+        BGJSV8Engine::GetInstance(isolate)->forwardJNIExceptionToV8();
+        return nullptr;
+    }
+    return byteBuffer;
+}
+
+v8::MaybeLocal<v8::Value> JNIV8Serializer::deserialize(v8::Local<v8::Context> context, const uint8_t *data, size_t length, jobjectArray hostObjects) {
+    v8::Isolate *isolate = context->GetIsolate();
+    v8::EscapableHandleScope scope(isolate);
+
+    DeserializerDelegate delegate(hostObjects);
+    v8::ValueDeserializer deserializer(isolate, data, length, &delegate);
+    delegate.deserializer = &deserializer;
+
+    v8::Local<v8::Value> valueRef;
+    if (deserializer.ReadHeader(context).IsNothing() || !deserializer.ReadValue(context).ToLocal(&valueRef)) {
+        return v8::MaybeLocal<v8::Value>();
+    }
+    return scope.Escape(valueRef);
+}
@@ -0,0 +1,51 @@
+//
+// Created on 19.10.26.
+//
+
+#ifndef ANDROID_TRADINGLIB_SAMPLE_JNIV8SERIALIZER_H
+#define ANDROID_TRADINGLIB_SAMPLE_JNIV8SERIALIZER_H
+
+#include "JNIV8Wrapper.h"
+
+/**
+ * Transfers js values to and from java in V8's structured clone format (v8::ValueSerializer)
+ * Typed arrays, dates, maps, sets etc. are preserved, and no intermediate strings are created.
+ * Js objects backed by a java object (JNIV8Object) are written as host objects: the java object is appended to a
+ * java List and only its index in that list is serialized.
+ */
+class JNIV8Serializer {
+public:
+    /**
+     * serializes the value into a new direct ByteBuffer
+     * if hostObjects is null, values backed by java objects can not be serialized
+     * requires the engine to be locked; returns nullptr if a js exception was thrown
+     */
+    static jobject serialize(v8::Local<v8::Context> context, v8::Local<v8::Value> value, jobject hostObjects);
+
+    /**
+     * deserializes a value from data
+     * hostObjects resolves the host object indices written by serialize and may be null
+     * requires the engine to be locked; returns an empty handle if a js exception was thrown
+     */
+    static v8::MaybeLocal<v8::Value> deserialize(v8::Local<v8::Context> context, const uint8_t *data, size_t length, jobjectArray hostObjects);
+
+    /**
+     * cache JNI class references
+     */
+    static void initJNICache();
+private:
+    class SerializerDelegate;
+    class DeserializerDelegate;
+
+    static struct {
+        jclass clazz;
+        jmethodID allocateDirectId;
+    } _jniByteBuffer;
+    static struct {
+        jclass clazz;
+        jmethodID sizeId;
+        jmethodID addId;
+    } _jniList;
+};
+
+#endif //ANDROID_TRADINGLIB_SAMPLE_JNIV8SERIALIZER_H
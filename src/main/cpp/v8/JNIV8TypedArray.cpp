@@ -5,10 +5,148 @@
 #include "JNIV8TypedArray.h"
 
 #include <stdlib.h>
+#include <cmath>
+#include <type_traits>
 
 BGJS_JNI_LINK(JNIV8TypedArray, "ag/boersego/bgjs/JNIV8TypedArray");
 
+/**
+ * converts a single element using the same semantics as a javascript assignment to a TypedArray
+ * (floating point values are truncated and wrapped when stored in integer arrays)
+ */
+template <typename TargetType, typename SourceType>
+static inline TargetType convertElement(SourceType value) {
+    if (std::is_floating_point<TargetType>::value || !std::is_floating_point<SourceType>::value) {
+        return static_cast<TargetType>(value);
+    }
+    double d = (double)value;
+    if (!std::isfinite(d)) {
+        return 0;
+    }
+    d = std::fmod(std::trunc(d), 18446744073709551616.0);
+    if (d < 0) {
+        d += 18446744073709551616.0;
+    }
+    return static_cast<TargetType>(static_cast<uint64_t>(d));
+}
+
+/**
+ * converts a single element for storage in a Uint8ClampedArray
+ */
+template <typename SourceType>
+static inline uint8_t clampElement(SourceType value) {
+    double d = (double)value;
+    if (!(d > 0)) {
+        return 0;
+    }
+    if (d >= 255) {
+        return 255;
+    }
+    return (uint8_t)std::nearbyint(d);
+}
+
+/**
+ * copies elements between the backing store of a TypedArray and a java array
+ * if both sides use the same representation this boils down to a single memcpy
+ */
+template <typename NativeType, typename JavaType>
+static void copyElements(NativeType *nativeData, JavaType *javaData, size_t length, bool read, bool clamped) {
+    const bool sameRepresentation = sizeof(NativeType) == sizeof(JavaType) &&
+                                    std::is_floating_point<NativeType>::value == std::is_floating_point<JavaType>::value;
+    if (read) {
+        if (sameRepresentation) {
+            memcpy(javaData, nativeData, length * sizeof(JavaType));
+        } else {
+            for (size_t i = 0; i < length; i++) {
+                javaData[i] = convertElement<JavaType>(nativeData[i]);
+            }
+        }
+    } else if (clamped) {
+        for (size_t i = 0; i < length; i++) {
+            nativeData[i] = clampElement(javaData[i]);
+        }
+    } else {
+        if (sameRepresentation) {
+            memcpy(nativeData, javaData, length * sizeof(JavaType));
+        } else {
+            for (size_t i = 0; i < length; i++) {
+                nativeData[i] = convertElement<NativeType>(javaData[i]);
+            }
+        }
+    }
+}
+
+/**
+ * shared implementation of all region read/write methods
+ * the whole region is transferred while holding the v8 lock once
+ */
+template <typename JavaType>
+static void transferRegion(JNIEnv *env, jobject obj, jint offset, jint length, jarray array, bool read) {
+    JNIV8Object_PrepareJNICall(JNIV8TypedArray, v8::Object, );
+
+    if (!array) {
+        env->ThrowNew(env->FindClass("java/lang/NullPointerException"), "array must not be null");
+        return;
+    }
+
+    v8::Local<v8::Object> objectRef = localRef;
+    if (objectRef->IsProxy()) {
+        objectRef = objectRef.As<v8::Proxy>()->GetTarget().As<v8::Object>();
+    }
+    v8::Local<v8::TypedArray> typedArrayRef = objectRef.As<v8::TypedArray>();
+
+    if (offset < 0 || length < 0 || (size_t)offset + (size_t)length > typedArrayRef->Length()) {
+        env->ThrowNew(env->FindClass("java/lang/IndexOutOfBoundsException"),
+                      "Region is out of bounds of the TypedArray");
+        return;
+    }
+    if (length > env->GetArrayLength(array)) {
+        env->ThrowNew(env->FindClass("java/lang/IndexOutOfBoundsException"),
+                      "Region is out of bounds of the java array");
+        return;
+    }
+    if (typedArrayRef->IsBigInt64Array() || typedArrayRef->IsBigUint64Array()) {
+        env->ThrowNew(env->FindClass("java/lang/IllegalArgumentException"),
+                      "BigInt TypedArrays are not supported");
+        return;
+    }
+    if (length == 0) {
+        return;
+    }
+
+    auto *bytes = (uint8_t *) typedArrayRef->Buffer()->Data() + typedArrayRef->ByteOffset();
+    const size_t elementSize = typedArrayRef->ByteLength() / typedArrayRef->Length();
+    void *nativeData = bytes + (size_t)offset * elementSize;
+
+    // no other JNI calls are allowed until the critical section is released again
+    auto *javaData = (JavaType *) env->GetPrimitiveArrayCritical(array, nullptr);
+    if (!javaData) {
+        return;
+    }
 
+    if (typedArrayRef->IsFloat32Array()) {
+        copyElements((float *) nativeData, javaData, (size_t)length, read, false);
+    } else if (typedArrayRef->IsFloat64Array()) {
+        copyElements((double *) nativeData, javaData, (size_t)length, read, false);
+    } else if (typedArrayRef->IsInt32Array()) {
+        copyElements((int32_t *) nativeData, javaData, (size_t)length, read, false);
+    } else if (typedArrayRef->IsUint32Array()) {
+        copyElements((uint32_t *) nativeData, javaData, (size_t)length, read, false);
+    } else if (typedArrayRef->IsInt16Array()) {
+        copyElements((int16_t *) nativeData, javaData, (size_t)length, read, false);
+    } else if (typedArrayRef->IsUint16Array()) {
+        copyElements((uint16_t *) nativeData, javaData, (size_t)length, read, false);
+    } else if (typedArrayRef->IsInt8Array()) {
+        copyElements((int8_t *) nativeData, javaData, (size_t)length, read, false);
+    } else if (typedArrayRef->IsUint8ClampedArray()) {
+        copyElements((uint8_t *) nativeData, javaData, (size_t)length, read, true);
+    } else {
+        copyElements((uint8_t *) nativeData, javaData, (size_t)length, read, false);
+    }
+
+    // when writing the java array was not modified, so a potential copy does not have to be written back
+    env->ReleasePrimitiveArrayCritical(array, javaData, read ? 0 : JNI_ABORT);
+}
 
 bool JNIV8TypedArray::isWrappableV8Object(v8::Local<v8::Object> object) {
     return object->IsTypedArray() || (object->IsProxy() && object.As<v8::Proxy>()->GetTarget()->IsTypedArray());
@@ -16,6 +154,14 @@ bool JNIV8TypedArray::isWrappableV8Object(v8::Local<v8::Object> object) {
 
 void JNIV8TypedArray::initializeJNIBindings(JNIClassInfo *info, bool isReload) {
     info->registerNativeMethod("getV8Length", "()I", (void *) JNIV8TypedArray::jniGetV8Length);
+    info->registerNativeMethod("readRegion", "(II[F)V", (void *) JNIV8TypedArray::jniReadFloatRegion);
+    info->registerNativeMethod("readRegion", "(II[D)V", (void *) JNIV8TypedArray::jniReadDoubleRegion);
+    info->registerNativeMethod("readRegion", "(II[I)V", (void *) JNIV8TypedArray::jniReadIntRegion);
+    info->registerNativeMethod("readRegion", "(II[B)V", (void *) JNIV8TypedArray::jniReadByteRegion);
+    info->registerNativeMethod("writeRegion", "(II[F)V", (void *) JNIV8TypedArray::jniWriteFloatRegion);
+    info->registerNativeMethod("writeRegion", "(II[D)V", (void *) JNIV8TypedArray::jniWriteDoubleRegion);
+    info->registerNativeMethod("writeRegion", "(II[I)V", (void *) JNIV8TypedArray::jniWriteIntRegion);
+    info->registerNativeMethod("writeRegion", "(II[B)V", (void *) JNIV8TypedArray::jniWriteByteRegion);
 }
 
 /**
@@ -26,6 +172,38 @@ jint JNIV8TypedArray::jniGetV8Length(JNIEnv *env, jobject obj) {
     return localRef->Length();
 }
 
+void JNIV8TypedArray::jniReadFloatRegion(JNIEnv *env, jobject obj, jint offset, jint length, jfloatArray target) {
+    transferRegion<jfloat>(env, obj, offset, length, target, true);
+}
+
+void JNIV8TypedArray::jniReadDoubleRegion(JNIEnv *env, jobject obj, jint offset, jint length, jdoubleArray target) {
+    transferRegion<jdouble>(env, obj, offset, length, target, true);
+}
+
+void JNIV8TypedArray::jniReadIntRegion(JNIEnv *env, jobject obj, jint offset, jint length, jintArray target) {
+    transferRegion<jint>(env, obj, offset, length, target, true);
+}
+
+void JNIV8TypedArray::jniReadByteRegion(JNIEnv *env, jobject obj, jint offset, jint length, jbyteArray target) {
+    transferRegion<jbyte>(env, obj, offset, length, target, true);
+}
+
+void JNIV8TypedArray::jniWriteFloatRegion(JNIEnv *env, jobject obj, jint offset, jint length, jfloatArray source) {
+    transferRegion<jfloat>(env, obj, offset, length, source, false);
+}
+
+void JNIV8TypedArray::jniWriteDoubleRegion(JNIEnv *env, jobject obj, jint offset, jint length, jdoubleArray source) {
+    transferRegion<jdouble>(env, obj, offset, length, source, false);
+}
+
+void JNIV8TypedArray::jniWriteIntRegion(JNIEnv *env, jobject obj, jint offset, jint length, jintArray source) {
+    transferRegion<jint>(env, obj, offset, length, source, false);
+}
+
+void JNIV8TypedArray::jniWriteByteRegion(JNIEnv *env, jobject obj, jint offset, jint length, jbyteArray source) {
+    transferRegion<jbyte>(env, obj, offset, length, source, false);
+}
+
 /**
  * cache JNI class references
  */
@@ -19,6 +19,24 @@ public:
     */
     static jint jniGetV8Length(JNIEnv *env, jobject obj);
 
+    /**
+     * copies a region of the TypedArray into a java primitive array
+     * elements are converted if the element type of the TypedArray does not match the java array
+     */
+    static void jniReadFloatRegion(JNIEnv *env, jobject obj, jint offset, jint length, jfloatArray target);
+    static void jniReadDoubleRegion(JNIEnv *env, jobject obj, jint offset, jint length, jdoubleArray target);
+    static void jniReadIntRegion(JNIEnv *env, jobject obj, jint offset, jint length, jintArray target);
+    static void jniReadByteRegion(JNIEnv *env, jobject obj, jint offset, jint length, jbyteArray target);
+
+    /**
+     * copies the contents of a java primitive array into a region of the TypedArray
+     * elements are converted if the element type of the TypedArray does not match the java array
+     */
+    static void jniWriteFloatRegion(JNIEnv *env, jobject obj, jint offset, jint length, jfloatArray source);
+    static void jniWriteDoubleRegion(JNIEnv *env, jobject obj, jint offset, jint length, jdoubleArray source);
+    static void jniWriteIntRegion(JNIEnv *env, jobject obj, jint offset, jint length, jintArray source);
+    static void jniWriteByteRegion(JNIEnv *env, jobject obj, jint offset, jint length, jbyteArray source);
+
     /**
      * cache JNI class references
      */
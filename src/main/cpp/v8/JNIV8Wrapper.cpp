@@ -13,14 +13,16 @@ using namespace v8;
 #include "JNIV8Symbol.h"
 #include "JNIV8ArrayBuffer.h"
 #include "JNIV8TypedArray.h"
+#include "JNIV8Key.h"
+#include "JNIV8FieldSchema.h"
+#include "JNIV8CollectionView.h"
+#include "JNIV8Serializer.h"
 #include "v8.h"
 
 #include <string>
 #include <algorithm>
 
-std::map<std::string, JNIV8ClassInfoContainer*> JNIV8Wrapper::_objmap;
-
-//const char* JNIV8Wrapper::_v8PrivateKey = "JNIV8WrapperPrivate";
+JNIClassRegistry<JNIV8ClassInfoContainer> JNIV8Wrapper::_containers;
 
 decltype(JNIV8Wrapper::_jniObject) JNIV8Wrapper::_jniObject = {0};
 decltype(JNIV8Wrapper::_jniV8FunctionInfo) JNIV8Wrapper::_jniV8FunctionInfo = {0};
@@ -48,6 +50,9 @@ void JNIV8Wrapper::init() {
     JNIV8Wrapper::registerObject<JNIV8ArrayBuffer>(JNIV8ObjectType::kWrapper);
     JNIV8Wrapper::registerObject<JNIV8TypedArray>(JNIV8ObjectType::kWrapper);
 
+    JNIWrapper::registerObject<JNIV8Key>();
+    JNIWrapper::registerObject<JNIV8FieldSchema>();
+
     JNIEnv *env = JNIWrapper::getEnvironment();
 
     _jniObject.clazz = (jclass)env->NewGlobalRef(env->FindClass("java/lang/Object"));
@@ -68,6 +73,8 @@ void JNIV8Wrapper::init() {
     _jniV8AccessorInfo.propertyId = env->GetFieldID(_jniV8AccessorInfo.clazz, "property", "Ljava/lang/String;");
     _jniV8AccessorInfo.getterId = env->GetFieldID(_jniV8AccessorInfo.clazz, "getter", "Ljava/lang/String;");
     _jniV8AccessorInfo.setterId = env->GetFieldID(_jniV8AccessorInfo.clazz, "setter", "Ljava/lang/String;");
+    _jniV8AccessorInfo.fieldId = env->GetFieldID(_jniV8AccessorInfo.clazz, "field", "Ljava/lang/String;");
+    _jniV8AccessorInfo.isReadOnlyId = env->GetFieldID(_jniV8AccessorInfo.clazz, "isReadOnly", "Z");
     _jniV8AccessorInfo.typeId = env->GetFieldID(_jniV8AccessorInfo.clazz, "type", "Ljava/lang/String;");
     _jniV8AccessorInfo.isStaticId = env->GetFieldID(_jniV8AccessorInfo.clazz, "isStatic", "Z");
     _jniV8AccessorInfo.isNullableId = env->GetFieldID(_jniV8AccessorInfo.clazz, "isNullable", "Z");
@@ -78,6 +85,10 @@ void JNIV8Wrapper::init() {
     JNIV8Array::initJNICache();
     JNIV8ClassInfo::initJNICache();
     JNIV8Marshalling::initJNICache();
+    JNIV8CollectionView::initJNICache();
+    JNIV8Serializer::initJNICache();
+    JNIV8Promise::initJNICache();
+    JNIV8PromiseResolver::initJNICache();
     BGJSV8Engine::initJNICache();
 }
 
@@ -134,23 +145,24 @@ void JNIV8Wrapper::v8ConstructorCallback(const v8::FunctionCallbackInfo<v8::Valu
     }
 }
 
-JNIV8ClassInfo* JNIV8Wrapper::_getV8ClassInfo(const std::string& canonicalName, BGJSV8Engine *engine) {
-    pthread_mutex_lock(&_mutexEnv);
+JNIV8ClassInfo* JNIV8Wrapper::_getV8ClassInfo(JNIV8ClassInfoContainer *container, BGJSV8Engine *engine) {
+    JNI_ASSERT(container, "Attempt to retrieve class info for unregistered class");
 
-    // find class info container
-    auto it = _objmap.find(canonicalName);
-    JNI_ASSERTF(it != _objmap.end(), "Attempt to retrieve class info for unregistered class: %s", canonicalName.c_str());
+    // class infos are owned by the engine and only accessed while holding its isolate lock
+    // => once a class was initialized for an engine no further locking is required
+    std::vector<JNIV8ClassInfo*> &classInfos = engine->_classInfos;
+    const size_t classId = container->classId;
+    if(classId < classInfos.size() && classInfos[classId]) {
+        return classInfos[classId];
+    }
 
-    // check if class info object already exists for this engine!
-    for(auto &it2 : it->second->classInfos) {
-        if(it2->engine == engine) {
-            pthread_mutex_unlock(&_mutexEnv);
-            return it2;
-        }
+    // if it was not found we have to create it now & link it with the engine
+    auto v8ClassInfo = new JNIV8ClassInfo(container, engine);
+    if(classInfos.size() <= classId) {
+        classInfos.resize(classId + 1, nullptr);
     }
-    // if it was not found we have to create it now & link it with the container
-    auto v8ClassInfo = new JNIV8ClassInfo(it->second, engine);
-    it->second->classInfos.push_back(v8ClassInfo);
+    classInfos[classId] = v8ClassInfo;
+    engine->_numClassTemplates.fetch_add(1, std::memory_order_relaxed);
 
     // initialize class info: template with constructor and general setup created here
     // individual methods and accessors handled by static method on subclass
@@ -159,7 +171,7 @@ JNIV8ClassInfo* JNIV8Wrapper::_getV8ClassInfo(const std::string& canonicalName,
 
     // v8 class name: canonical name with underscores instead of slashes
     // e.g. ag/boersego/bgjs/Test becomes ag_boersego_bgjs_Test
-    std::string strV8ClassName = canonicalName;
+    std::string strV8ClassName = container->canonicalName;
     std::replace(strV8ClassName.begin(), strV8ClassName.end(), '/', '_');
 
     Local<External> data = External::New(isolate, (void*)v8ClassInfo);
@@ -170,13 +182,7 @@ JNIV8ClassInfo* JNIV8Wrapper::_getV8ClassInfo(const std::string& canonicalName,
     if(v8ClassInfo->container->baseClassInfo) {
         JNIV8ClassInfo *baseInfo = nullptr;
         // base classinfo might not have been initialized yet => do so now!
-        _getV8ClassInfo(v8ClassInfo->container->baseClassInfo->canonicalName, engine);
-        for(auto &it2 : v8ClassInfo->container->baseClassInfo->classInfos) {
-            if(it2->engine == engine) {
-                baseInfo = it2;
-                break;
-            }
-        }
+        baseInfo = _getV8ClassInfo(v8ClassInfo->container->baseClassInfo, engine);
         JNI_ASSERT(baseInfo, "Failed to retrieve baseclass info");
         Local<FunctionTemplate> baseFT = Local<FunctionTemplate>::New(isolate, baseInfo->functionTemplate);
         ft->Inherit(baseFT);
@@ -189,109 +195,175 @@ JNIV8ClassInfo* JNIV8Wrapper::_getV8ClassInfo(const std::string& canonicalName,
     v8ClassInfo->functionTemplate.Reset(isolate, ft);
 
     // if this is a pure java class it might not have an initializer
-    if(it->second->initializer) {
-        it->second->initializer(v8ClassInfo);
+    if(container->initializer) {
+        container->initializer(v8ClassInfo);
     }
 
     // but it might have bindings on java that need to be processed
-    // binding classes + methods do not need to be cached here, because they are only used once per Engine upon initialization!
+    // they are resolved once and then only registered for every further engine
+    if(container->clsBinding && container->clsObject) {
+        pthread_mutex_lock(&_mutexEnv);
+        if(!container->bindingsResolved) {
+            _resolveJavaBindings(container);
+        }
+        pthread_mutex_unlock(&_mutexEnv);
+        _registerJavaBindings(container, v8ClassInfo);
+    }
+
+    return v8ClassInfo;
+}
+
+/**
+ * reads the bindings declared by the generated V8Binding class of a container
+ * type signatures are parsed and method ids looked up here, exactly once per class
+ */
+void JNIV8Wrapper::_resolveJavaBindings(JNIV8ClassInfoContainer *container) {
     JNIEnv *env = JNIWrapper::getEnvironment();
-    jclass clsObject = it->second->clsObject;
-    jclass clsBinding = it->second->clsBinding;
-    if(clsBinding && clsObject) {
-        jfieldID createFromJavaOnlyId = env->GetStaticFieldID(clsBinding, "createFromJavaOnly", "Z");
-        v8ClassInfo->createFromJavaOnly = env->GetStaticBooleanField(clsBinding, createFromJavaOnlyId);
-
-        jmethodID getFunctionsMethodId = env->GetStaticMethodID(clsBinding, "getV8Functions",
-                                                                "()[Lag/boersego/v8annotations/generated/V8FunctionInfo;");
-        jmethodID getAccessorsMethodId = env->GetStaticMethodID(clsBinding, "getV8Accessors",
-                                                                "()[Lag/boersego/v8annotations/generated/V8AccessorInfo;");
-
-        // first register functions
-        auto functionInfos = (jobjectArray) env->CallStaticObjectMethod(clsBinding,
-                                                                                getFunctionsMethodId);
-        for(jsize idx=0,n=env->GetArrayLength(functionInfos);idx<n;idx++) {
-            jobject functionInfo = env->GetObjectArrayElement(functionInfos, idx);
-            const std::string strFunctionName = JNIWrapper::jstring2string((jstring)env->GetObjectField(functionInfo, _jniV8FunctionInfo.propertyId));
-            const std::string strMethodName = JNIWrapper::jstring2string((jstring)env->GetObjectField(functionInfo, _jniV8FunctionInfo.methodId));
-            const std::string strReturnType = JNIWrapper::jstring2string((jstring)env->GetObjectField(functionInfo, _jniV8FunctionInfo.returnTypeId));
-            auto argumentInfos = (jobjectArray)env->GetObjectField(functionInfo, _jniV8FunctionInfo.argumentsId);
-            std::vector<JNIV8JavaValue>* arguments = nullptr;
-
-            // return type information
-            const JNIV8JavaValue returnType = JNIV8Marshalling::persistentValueWithTypeSignature(strReturnType);
-
-            // build signature string and collect argument information
-            std::string strSignature = "(";
-            if(env->IsSameObject(argumentInfos, nullptr)) {
-                strSignature = "([Ljava/lang/Object;)" + strReturnType;
+    jclass clsObject = container->clsObject;
+    jclass clsBinding = container->clsBinding;
+
+    jfieldID createFromJavaOnlyId = env->GetStaticFieldID(clsBinding, "createFromJavaOnly", "Z");
+    container->createFromJavaOnly = env->GetStaticBooleanField(clsBinding, createFromJavaOnlyId);
+
+    jmethodID getFunctionsMethodId = env->GetStaticMethodID(clsBinding, "getV8Functions",
+                                                            "()[Lag/boersego/v8annotations/generated/V8FunctionInfo;");
+    jmethodID getAccessorsMethodId = env->GetStaticMethodID(clsBinding, "getV8Accessors",
+                                                            "()[Lag/boersego/v8annotations/generated/V8AccessorInfo;");
+
+    // first collect functions
+    auto functionInfos = (jobjectArray) env->CallStaticObjectMethod(clsBinding,
+                                                                            getFunctionsMethodId);
+    for(jsize idx=0,n=env->GetArrayLength(functionInfos);idx<n;idx++) {
+        JNILocalFrame localFrame(env, 8);
+        jobject functionInfo = env->GetObjectArrayElement(functionInfos, idx);
+        const std::string strFunctionName = JNIWrapper::jstring2string((jstring)env->GetObjectField(functionInfo, _jniV8FunctionInfo.propertyId));
+        const std::string strMethodName = JNIWrapper::jstring2string((jstring)env->GetObjectField(functionInfo, _jniV8FunctionInfo.methodId));
+        const std::string strReturnType = JNIWrapper::jstring2string((jstring)env->GetObjectField(functionInfo, _jniV8FunctionInfo.returnTypeId));
+        auto argumentInfos = (jobjectArray)env->GetObjectField(functionInfo, _jniV8FunctionInfo.argumentsId);
+
+        // return type information
+        JNIV8JavaBinding binding(JNIV8JavaBinding::Kind::kMethod, strFunctionName,
+                                 JNIV8Marshalling::persistentValueWithTypeSignature(strReturnType));
+
+        // build signature string and collect argument information
+        std::string strSignature = "(";
+        if(env->IsSameObject(argumentInfos, nullptr)) {
+            strSignature = "([Ljava/lang/Object;)" + strReturnType;
+        } else {
+            binding.arguments = new std::vector<JNIV8JavaValue>();
+            jsize numArguments = env->GetArrayLength(argumentInfos);
+            for(jsize argIdx=0; argIdx<numArguments; argIdx++) {
+                jobject argumentInfo = env->GetObjectArrayElement(argumentInfos, argIdx);
+                const std::string strArgumentType = JNIWrapper::jstring2string((jstring)env->GetObjectField(argumentInfo, _jniV8FunctionArgumentInfo.typeId));
+                JNIV8MarshallingFlags flags = JNIV8MarshallingFlags::kDefault;
+                if(!(bool)env->GetBooleanField(argumentInfo, _jniV8FunctionArgumentInfo.isNullableId)) flags = JNIV8MarshallingFlags::kNonNull;
+                if((bool)env->GetBooleanField(argumentInfo, _jniV8FunctionArgumentInfo.undefinedIsNullId)) flags = (JNIV8MarshallingFlags)(flags|JNIV8MarshallingFlags::kUndefinedIsNull);
+                binding.arguments->push_back(JNIV8Marshalling::persistentArgumentWithTypeSignature(strArgumentType, flags));
+                strSignature += strArgumentType;
+                env->DeleteLocalRef(argumentInfo);
+            }
+            strSignature += ")" + strReturnType;
+        }
+
+        binding.isStatic = env->GetBooleanField(functionInfo, _jniV8FunctionInfo.isStaticId);
+        if(binding.isStatic) {
+            binding.methodId = env->GetStaticMethodID(clsObject, strMethodName.c_str(), strSignature.c_str());
+        } else {
+            binding.methodId = env->GetMethodID(clsObject, strMethodName.c_str(), strSignature.c_str());
+        }
+        container->javaBindings.push_back(binding);
+    }
+
+    // now collect all property accessors
+    auto accessorInfos = (jobjectArray) env->CallStaticObjectMethod(clsBinding,
+                                                                            getAccessorsMethodId);
+    for(jsize idx=0,n=env->GetArrayLength(accessorInfos);idx<n;idx++) {
+        JNILocalFrame localFrame(env, 8);
+        jobject accessorInfo = env->GetObjectArrayElement(accessorInfos, idx);
+        const std::string strPropertyType = JNIWrapper::jstring2string((jstring)env->GetObjectField(accessorInfo, _jniV8AccessorInfo.typeId));
+        JNIV8MarshallingFlags flags = JNIV8MarshallingFlags::kDefault;
+        if(!(bool)env->GetBooleanField(accessorInfo, _jniV8AccessorInfo.isNullableId)) flags = JNIV8MarshallingFlags::kNonNull;
+        if((bool)env->GetBooleanField(accessorInfo, _jniV8AccessorInfo.undefinedIsNullId)) flags = (JNIV8MarshallingFlags)(flags|JNIV8MarshallingFlags::kUndefinedIsNull);
+
+        const std::string strPropertyName = JNIWrapper::jstring2string((jstring)env->GetObjectField(accessorInfo, _jniV8AccessorInfo.propertyId));
+        const std::string strGetterName = JNIWrapper::jstring2string((jstring)env->GetObjectField(accessorInfo, _jniV8AccessorInfo.getterId));
+        const std::string strSetterName = JNIWrapper::jstring2string((jstring)env->GetObjectField(accessorInfo, _jniV8AccessorInfo.setterId));
+        const std::string strFieldName = JNIWrapper::jstring2string((jstring)env->GetObjectField(accessorInfo, _jniV8AccessorInfo.fieldId));
+
+        JNIV8JavaBinding binding(JNIV8JavaBinding::Kind::kAccessor, strPropertyName,
+                                 JNIV8Marshalling::persistentArgumentWithTypeSignature(strPropertyType, flags));
+        binding.isStatic = env->GetBooleanField(accessorInfo, _jniV8AccessorInfo.isStaticId);
+
+        if(!strFieldName.empty()) {
+            // property is bound directly to a field
+            binding.kind = JNIV8JavaBinding::Kind::kFieldAccessor;
+            binding.isReadOnly = env->GetBooleanField(accessorInfo, _jniV8AccessorInfo.isReadOnlyId);
+            if(binding.isStatic) {
+                binding.fieldId = env->GetStaticFieldID(clsObject, strFieldName.c_str(), strPropertyType.c_str());
             } else {
-                arguments = new std::vector<JNIV8JavaValue>();
-                jsize numArguments = env->GetArrayLength(argumentInfos);
-                // collect arguments
-                // ownership of malloc'ed memory is implicitly transferred to JNIV8ClassInfo!
-                if(numArguments>0) {
-                    for(jsize argIdx=0; argIdx<numArguments; argIdx++) {
-                        jobject argumentInfo = env->GetObjectArrayElement(argumentInfos, argIdx);
-                        const std::string strArgumentType = JNIWrapper::jstring2string((jstring)env->GetObjectField(argumentInfo, _jniV8FunctionArgumentInfo.typeId));
-                        JNIV8MarshallingFlags flags = JNIV8MarshallingFlags::kDefault;
-                        if(!(bool)env->GetBooleanField(argumentInfo, _jniV8FunctionArgumentInfo.isNullableId)) flags = JNIV8MarshallingFlags::kNonNull;
-                        if((bool)env->GetBooleanField(argumentInfo, _jniV8FunctionArgumentInfo.undefinedIsNullId)) flags = (JNIV8MarshallingFlags)(flags|JNIV8MarshallingFlags::kUndefinedIsNull);
-                        JNIV8JavaValue argument = JNIV8Marshalling::persistentArgumentWithTypeSignature(strArgumentType, flags);
-                        arguments->push_back(argument);
-                        strSignature += strArgumentType;
+                binding.fieldId = env->GetFieldID(clsObject, strFieldName.c_str(), strPropertyType.c_str());
+            }
+        } else if(binding.isStatic) {
+            if (!strGetterName.empty()) { binding.getterId = env->GetStaticMethodID(clsObject, strGetterName.c_str(), ("()" + strPropertyType).c_str()); }
+            if (!strSetterName.empty()) { binding.setterId = env->GetStaticMethodID(clsObject, strSetterName.c_str(), ("(" + strPropertyType + ")V").c_str()); }
+        } else {
+            if (!strGetterName.empty()) { binding.getterId = env->GetMethodID(clsObject, strGetterName.c_str(), ("()" + strPropertyType).c_str()); }
+            if (!strSetterName.empty()) { binding.setterId = env->GetMethodID(clsObject, strSetterName.c_str(), ("(" + strPropertyType + ")V").c_str()); }
+        }
+        container->javaBindings.push_back(binding);
+    }
+
+    env->DeleteLocalRef(functionInfos);
+    env->DeleteLocalRef(accessorInfos);
+    container->bindingsResolved = true;
+}
+
+/**
+ * registers the resolved bindings of a container with the class info of an engine
+ * class info objects own the type references and argument lists they are given, so those are duplicated
+ */
+void JNIV8Wrapper::_registerJavaBindings(JNIV8ClassInfoContainer *container, JNIV8ClassInfo *v8ClassInfo) {
+    JNIEnv *env = JNIWrapper::getEnvironment();
+
+    v8ClassInfo->createFromJavaOnly = container->createFromJavaOnly;
+
+    for(auto &binding : container->javaBindings) {
+        JNIV8JavaValue type = binding.type;
+
+        if(binding.kind == JNIV8JavaBinding::Kind::kMethod) {
+            // return types are not released by the class info, so the reference of the container can be shared
+            std::vector<JNIV8JavaValue> *arguments = nullptr;
+            if(binding.arguments) {
+                arguments = new std::vector<JNIV8JavaValue>(*binding.arguments);
+                for(auto &argument : *arguments) {
+                    if(argument.clazz) {
+                        argument.clazz = (jclass)env->NewGlobalRef(argument.clazz);
                     }
                 }
-                strSignature += ")" + strReturnType;
             }
-
-            // finally register the method
-            jmethodID javaMethodId;
-            if(env->GetBooleanField(functionInfo, _jniV8FunctionInfo.isStaticId)) {
-                javaMethodId = env->GetStaticMethodID(clsObject, strMethodName.c_str(),
-                                                strSignature.c_str());
-                v8ClassInfo->registerStaticJavaMethod(strFunctionName, javaMethodId,
-                                                      returnType,
-                                                      arguments);
+            if(binding.isStatic) {
+                v8ClassInfo->registerStaticJavaMethod(binding.name, binding.methodId, type, arguments);
             } else {
-                javaMethodId = env->GetMethodID(clsObject, strMethodName.c_str(),
-                                                strSignature.c_str());
-                v8ClassInfo->registerJavaMethod(strFunctionName, javaMethodId,
-                                                returnType,
-                                                arguments);
+                v8ClassInfo->registerJavaMethod(binding.name, binding.methodId, type, arguments);
             }
+            continue;
         }
 
-        // now register all property accessors
-        auto accessorInfos = (jobjectArray) env->CallStaticObjectMethod(clsBinding,
-                                                                                getAccessorsMethodId);
-        for(jsize idx=0,n=env->GetArrayLength(accessorInfos);idx<n;idx++) {
-            jobject accessorInfo = env->GetObjectArrayElement(accessorInfos, idx);
-            const std::string strPropertyType = JNIWrapper::jstring2string((jstring)env->GetObjectField(accessorInfo, _jniV8AccessorInfo.typeId));
-            JNIV8MarshallingFlags flags = JNIV8MarshallingFlags::kDefault;
-            if(!(bool)env->GetBooleanField(accessorInfo, _jniV8AccessorInfo.isNullableId)) flags = JNIV8MarshallingFlags::kNonNull;
-            if((bool)env->GetBooleanField(accessorInfo, _jniV8AccessorInfo.undefinedIsNullId)) flags = (JNIV8MarshallingFlags)(flags|JNIV8MarshallingFlags::kUndefinedIsNull);
-            const JNIV8JavaValue property = JNIV8Marshalling::persistentArgumentWithTypeSignature(strPropertyType, flags);
-
-            const std::string strPropertyName = JNIWrapper::jstring2string((jstring)env->GetObjectField(accessorInfo, _jniV8AccessorInfo.propertyId));
-            const std::string strGetterName = JNIWrapper::jstring2string((jstring)env->GetObjectField(accessorInfo, _jniV8AccessorInfo.getterId));
-            const std::string strSetterName = JNIWrapper::jstring2string((jstring)env->GetObjectField(accessorInfo, _jniV8AccessorInfo.setterId));
-            jmethodID javaGetterId = nullptr, javaSetterId = nullptr;
-            if(env->GetBooleanField(accessorInfo, _jniV8AccessorInfo.isStaticId)) {
-                if (!strGetterName.empty()) { javaGetterId = env->GetStaticMethodID(clsObject, strGetterName.c_str(), ("()" + strPropertyType).c_str()); }
-                if (!strSetterName.empty()) { javaSetterId = env->GetStaticMethodID(clsObject, strSetterName.c_str(), ("(" + strPropertyType + ")V").c_str()); }
-                v8ClassInfo->registerStaticJavaAccessor(strPropertyName, property, javaGetterId, javaSetterId);
+        if(type.clazz) {
+            type.clazz = (jclass)env->NewGlobalRef(type.clazz);
+        }
+        if(binding.kind == JNIV8JavaBinding::Kind::kFieldAccessor) {
+            if(binding.isStatic) {
+                v8ClassInfo->registerStaticJavaFieldAccessor(binding.name, type, binding.fieldId, binding.isReadOnly);
             } else {
-                if (!strGetterName.empty()) { javaGetterId = env->GetMethodID(clsObject, strGetterName.c_str(), ("()" + strPropertyType).c_str()); }
-                if (!strSetterName.empty()) { javaSetterId = env->GetMethodID(clsObject, strSetterName.c_str(), ("(" + strPropertyType + ")V").c_str()); }
-                v8ClassInfo->registerJavaAccessor(strPropertyName, property, javaGetterId, javaSetterId);
+                v8ClassInfo->registerJavaFieldAccessor(binding.name, type, binding.fieldId, binding.isReadOnly);
             }
+        } else if(binding.isStatic) {
+            v8ClassInfo->registerStaticJavaAccessor(binding.name, type, binding.getterId, binding.setterId);
+        } else {
+            v8ClassInfo->registerJavaAccessor(binding.name, type, binding.getterId, binding.setterId);
         }
     }
-
-    pthread_mutex_unlock(&_mutexEnv);
-
-    return v8ClassInfo;
 }
 
 void JNIV8Wrapper::initializeNativeJNIV8Object(jobject obj, jobject engineObj, jlong jsObjPtr) {
@@ -310,7 +382,7 @@ void JNIV8Wrapper::initializeNativeJNIV8Object(jobject obj, jobject engineObj, j
     v8::Persistent<Object>* persistentPtr;
     v8::Local<Object> jsObj;
 
-    auto *classInfo = JNIV8Wrapper::_getV8ClassInfo(v8Object->getCanonicalName(), engine.get());
+    auto *classInfo = JNIV8Wrapper::_getV8ClassInfo(_getContainer(v8Object->getClassId()), engine.get());
 
     // if an object was already supplied we just need to extract it and store it
     if(jsObjPtr) {
@@ -331,20 +403,28 @@ void JNIV8Wrapper::initializeNativeJNIV8Object(jobject obj, jobject engineObj, j
 void JNIV8Wrapper::_registerObject(JNIV8ObjectType type, const std::string& canonicalName, const std::string& baseCanonicalName, JNIV8ObjectInitializer i, JNIV8ObjectCreator c, size_t size) {
     // canonicalName may be already registered
     // (e.g. when called from JNI_OnLoad; when using multiple linked libraries it is called once for each library)
-    auto it = _objmap.find(canonicalName);
-    if (it != _objmap.end()) {
-        JNI_ASSERTF(!i && !it->second->initializer, "Class %s registered both from native and java", canonicalName.c_str());
+    // the java class has to be registered with JNIWrapper first; its id is shared
+    pthread_mutex_lock(&_mutexEnv);
+    const size_t classId = JNIWrapper::getClassId(canonicalName);
+    if (classId == JNIClassInfo::kInvalidClassId) {
+        pthread_mutex_unlock(&_mutexEnv);
+        return;
+    }
+    JNIV8ClassInfoContainer *existing = _getContainer(classId);
+    if (existing) {
+        JNI_ASSERTF(!i && !existing->initializer, "Class %s registered both from native and java", canonicalName.c_str());
+        pthread_mutex_unlock(&_mutexEnv);
         return;
     }
 
     // base class has to be registered if it is not JNIV8Object (which is only registered with JNIWrapper, because it provides no JS functionality on its own)
     JNIV8ClassInfoContainer *baseInfo = nullptr;
     if (!baseCanonicalName.empty()) {
-        it = _objmap.find(baseCanonicalName);
-        if (it == _objmap.end()) {
+        baseInfo = _getContainer(JNIWrapper::getClassId(baseCanonicalName));
+        if (!baseInfo) {
+            pthread_mutex_unlock(&_mutexEnv);
             return;
         }
-        baseInfo = it->second;
     } else if(canonicalName != JNIBase::getCanonicalName<JNIV8Object>()) {
         // an empty base class is only allowed here for internally registering JNIObject itself
         JNI_ASSERT(0, "Attempt to register an object without super class");
@@ -356,6 +436,7 @@ void JNIV8Wrapper::_registerObject(JNIV8ObjectType type, const std::string& cano
             JNIV8ClassInfoContainer *baseInfo2 = baseInfo;
             do {
                 if (baseInfo2->type != JNIV8ObjectType::kWrapper && baseInfo2->baseClassInfo) {
+                    pthread_mutex_unlock(&_mutexEnv);
                     return;
                 }
                 baseInfo2 = baseInfo->baseClassInfo;
@@ -363,12 +444,15 @@ void JNIV8Wrapper::_registerObject(JNIV8ObjectType type, const std::string& cano
         } else if (baseInfo->type == JNIV8ObjectType::kWrapper &&
                    baseInfo->type != type) {
             // wrapper classes can only be extended by other wrapper classes!
+            pthread_mutex_unlock(&_mutexEnv);
             return;
         }
     }
 
-    auto *info = new JNIV8ClassInfoContainer(type, canonicalName, i, c, size, baseInfo);
-    _objmap[canonicalName] = info;
+    auto *info = new JNIV8ClassInfoContainer(classId, type, canonicalName, i, c, size, baseInfo);
+
+    _containers.set(classId, info);
+    pthread_mutex_unlock(&_mutexEnv);
 }
 
 // persistent classes can also be accessed as JNIV8Object directly!
@@ -380,7 +464,8 @@ template<> JNILocalRef<JNIV8Object> JNIV8Wrapper::wrapObject<JNIV8Object>(
     // we still need a handle scope however...
     v8::HandleScope scope(isolate);
 
-    if (object->InternalFieldCount() >= 1) {
+    // objects with internal fields that do not hold a JNIV8Object (e.g. collection views) keep field 0 empty
+    if (object->InternalFieldCount() >= 1 && object->GetInternalField(0).As<v8::Value>()->IsExternal()) {
         // does the object have internal fields? if so use it!
         ext = object->GetInternalField(0).As<v8::External>();
     } else {
@@ -393,15 +478,8 @@ template<> JNILocalRef<JNIV8Object> JNIV8Wrapper::wrapObject<JNIV8Object>(
  * internal helper function called by V8Engine on destruction
  */
 void JNIV8Wrapper::cleanupV8Engine(BGJSV8Engine *engine) {
-    pthread_mutex_lock(&_mutexEnv);
-    for(auto &it : _objmap) {
-        for (auto it2 = it.second->classInfos.begin(); it2 != it.second->classInfos.end(); ++it2) {
-            if((*it2)->engine == engine) {
-                delete *it2;
-                it.second->classInfos.erase(it2);
-                break;
-            }
-        }
+    for(auto *classInfo : engine->_classInfos) {
+        delete classInfo;
     }
-    pthread_mutex_unlock(&_mutexEnv);
+    engine->_classInfos.clear();
 }
\ No newline at end of file
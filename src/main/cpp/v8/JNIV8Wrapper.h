@@ -12,6 +12,8 @@
 
 #include "JNIV8Object.h"
 
+#include <atomic>
+
 class JNIV8Wrapper {
 public:
     static void init();
@@ -113,8 +115,8 @@ public:
      */
     template <typename ObjectType> static
     JNILocalRef<ObjectType> wrapObject(v8::Local<v8::Object> object) {
-        auto it = _objmap.find(JNIBase::getCanonicalName<ObjectType>());
-        if (it == _objmap.end()) {
+        JNIV8ClassInfoContainer *info = _getContainer(JNIWrapper::getClassId<ObjectType>());
+        if (!info) {
             return nullptr;
         }
 
@@ -126,40 +128,41 @@ public:
         // we still need a handle scope however...
         v8::HandleScope scope(isolate);
 
-        JNIV8ClassInfoContainer *info = it->second;
-
         if(info->type == JNIV8ObjectType::kWrapper) {
             // make sure the object is actually supported by the specified type
             if(!ObjectType::isWrappableV8Object(object)) {
                 return nullptr;
             }
-            /*
-            // does the object have a native object stored in a private key?
-            auto privateKey = v8::Private::ForApi(isolate, v8::String::NewFromUtf8(isolate, _v8PrivateKey));
-            auto privateValue = object->GetPrivate(isolate->GetCurrentContext(), privateKey);
-            if (!privateValue.IsEmpty()) {
-                ext = privateValue.ToLocalChecked().As<v8::External>();
-            } else {
-                // the private key was empty so we have to create a new object
-                v8::Persistent<v8::Object>* persistent = new v8::Persistent<v8::Object>(isolate, object);
-                auto sharedPtr = info->creator(_getV8ClassInfo(JNIBase::getCanonicalName<ObjectType>(), BGJSV8Engine::GetInstance(isolate)), persistent);
-
-                // store in private
-                object->SetPrivate(isolate->GetCurrentContext(), privateKey, v8::External::New(isolate, sharedPtr.get()));
+            BGJSV8Engine *engine = BGJSV8Engine::GetInstance(isolate);
+            JNIEnv *env = JNIWrapper::getEnvironment();
 
-                return std::static_pointer_cast<ObjectType>(sharedPtr);
+            // does the object already have a wrapper stored in a private key?
+            // the slot is cleared by the wrapper when it is destroyed, and destruction is guarded by the same lock
+            // that is held here, so the pointer is valid. The java object might however already be unreachable
+            // and waiting to be disposed: in that case the weak reference is cleared, and a new wrapper is required.
+            v8::Local<v8::Value> cachedValue;
+            if (object->GetPrivate(isolate->GetCurrentContext(), engine->getWrapperCacheKey()).ToLocal(&cachedValue) &&
+                    cachedValue->IsExternal()) {
+                ptr = reinterpret_cast<JNIV8Object*>(cachedValue.As<v8::External>()->Value());
+                if (JNIWrapper::isObjectInstanceOf<ObjectType>(ptr)) {
+                    jobject cachedObj = ptr->getJObject();
+                    if (cachedObj) {
+                        JNIRetainedRef<ObjectType> retainedRef(reinterpret_cast<ObjectType*>(ptr));
+                        env->DeleteLocalRef(cachedObj);
+                        return JNILocalRef<ObjectType>::New(retainedRef);
+                    }
+                }
             }
-             */
-            // a new wrapper object is created every time!
+
+            // no usable wrapper exists yet; the new one registers itself in the private key when it is linked
             v8::Persistent<v8::Object>* persistent = new v8::Persistent<v8::Object>(isolate, object);
-            JNIEnv *env = JNIWrapper::getEnvironment();
             jobjectArray arguments = env->NewObjectArray(0, _jniObject.clazz, nullptr);
             // __android_log_print(ANDROID_LOG_WARN, "JNIV8Wrapper", "Creating %s", JNIBase::getCanonicalName<ObjectType>().c_str());
-            auto retainedRef = JNIRetainedRef<ObjectType>::Cast(info->creator(_getV8ClassInfo(JNIBase::getCanonicalName<ObjectType>(), BGJSV8Engine::GetInstance(isolate)), persistent, arguments));
+            auto retainedRef = JNIRetainedRef<ObjectType>::Cast(info->creator(_getV8ClassInfo(info, engine), persistent, arguments));
             env->DeleteLocalRef(arguments);
             return JNILocalRef<ObjectType>::New(retainedRef);
         } else {
-            if (object->InternalFieldCount() >= 1) {
+            if (object->InternalFieldCount() >= 1 && object->GetInternalField(0).As<v8::Value>()->IsExternal()) {
                 // does the object have internal fields? if so use it!
                 ext = object->GetInternalField(0).As<v8::External>();
             } else {
@@ -179,10 +182,10 @@ public:
      */
     template <typename ObjectType> static
     v8::Local<v8::Function> getJSConstructor(BGJSV8Engine *engine) {
-        return _getV8ClassInfo(JNIBase::getCanonicalName<ObjectType>(), engine)->getConstructor();
+        return _getV8ClassInfo(_getContainer(JNIWrapper::getClassId<ObjectType>()), engine)->getConstructor();
     }
     static v8::Local<v8::Function> getJSConstructor(BGJSV8Engine *engine, const std::string &canonicalName) {
-        return _getV8ClassInfo(canonicalName, engine)->getConstructor();
+        return _getV8ClassInfo(_getContainer(JNIWrapper::getClassId(canonicalName)), engine)->getConstructor();
     }
 
     /**
@@ -202,13 +205,18 @@ public:
      */
     static void cleanupV8Engine(BGJSV8Engine *engine);
 private:
-    //static const char* _v8PrivateKey;
-
     static void _registerObject(JNIV8ObjectType type, const std::string& canonicalName, const std::string& baseCanonicalName, JNIV8ObjectInitializer i, JNIV8ObjectCreator c, size_t size);
-    static JNIV8ClassInfo* _getV8ClassInfo(const std::string& canonicalName, BGJSV8Engine *engine);
+    static JNIV8ClassInfo* _getV8ClassInfo(JNIV8ClassInfoContainer *container, BGJSV8Engine *engine);
+    static void _resolveJavaBindings(JNIV8ClassInfoContainer *container);
+    static void _registerJavaBindings(JNIV8ClassInfoContainer *container, JNIV8ClassInfo *v8ClassInfo);
+    static JNIV8ClassInfoContainer* _getContainer(size_t classId) {
+        return _containers.get(classId);
+    }
 
-    static std::map<std::string, JNIV8ClassInfoContainer*> _objmap;
+    // registered classes indexed by the class id assigned by JNIWrapper; lookups do not need a lock
+    static JNIClassRegistry<JNIV8ClassInfoContainer> _containers;
 
+    // guards registration and the resolution of java bindings; never taken once a class is initialized for an engine
     static pthread_mutex_t _mutexEnv;
 
     template<class ObjectType>
@@ -247,6 +255,8 @@ private:
         jfieldID propertyId;
         jfieldID getterId;
         jfieldID setterId;
+        jfieldID fieldId;
+        jfieldID isReadOnlyId;
         jfieldID isStaticId;
         jfieldID isNullableId;
         jfieldID undefinedIsNullId;
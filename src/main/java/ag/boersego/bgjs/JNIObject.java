@@ -68,6 +68,8 @@ public abstract class JNIObject {
     /**
      * the jni side of some objects can be manually disposed before they are gc'd using this method
      * only possible for temporary wrapper objects, e.g. JNIV8GenericObject
+     * wrappers are shared between all callers that received them; for those, this only releases a share
+     * taken with JNIV8Object.retain, if there is one
      */
     protected void dispose() throws RuntimeException {
         if(nativeHandle == 0) {
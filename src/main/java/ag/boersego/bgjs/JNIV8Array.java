@@ -79,12 +79,27 @@ public final class JNIV8Array extends JNIV8Object implements Iterable<Object> {
         return (T) _getV8Element(V8Flags.Default, returnType.hashCode(), returnType, index);
     }
 
+    /**
+     * reads the fields described by the schema from all elements of the array with a single call
+     * target must have room for getV8Length() * schema.getFieldCount() values; values are stored element after element
+     * fields of elements that are not objects are returned as NaN
+     */
+    public native void readElementFields(@NonNull V8FieldSchema schema, @NonNull double[] target);
+
+    /**
+     * writes source.length / schema.getFieldCount() elements with the fields described by the schema with a single call
+     * elements that are not objects yet are replaced with new objects; the array grows if required
+     */
+    public native void writeElementFields(@NonNull V8FieldSchema schema, @NonNull double[] source);
+
     /**
      * releases the JS array
      * when working with a lot of objects, calling this manually might improve memory usage
      * using this method is completely optional
      *
-     * NOTE: object must not be used anymore after calling this method
+     * NOTE: the same wrapper is shared by everybody who received this array from JS; if shares were taken with
+     * retain(), disposing only releases one of them, and the array is released when all shares have been released.
+     * The caller must not use the object anymore after calling this method.
      */
     @Override
     public void dispose() throws RuntimeException {
@@ -16,8 +16,40 @@ public final class JNIV8Function extends JNIV8Object {
         Object Callback(@NonNull Object receiver, @NonNull Object[] arguments);
     }
 
+    /**
+     * Handlers with primitive signatures are called without boxing the arguments or allocating an argument array.
+     * Use them for functions that are called very often from JavaScript, e.g. formatters called once per data point.
+     * Missing arguments are treated as undefined and converted the same way JavaScript would convert them.
+     */
+    public interface DoubleToDoubleHandler {
+        double Callback(double value);
+    }
+
+    public interface DoubleDoubleToVoidHandler {
+        void Callback(double value1, double value2);
+    }
+
+    public interface IntToObjectHandler {
+        Object Callback(int value);
+    }
+
+    public interface StringToStringHandler {
+        /**
+         * @param value the argument converted to a string, or null if it was null or undefined
+         */
+        String Callback(@Nullable String value);
+    }
+
     public static native JNIV8Function Create(V8Engine engine, JNIV8Function.Handler handler);
 
+    public static native JNIV8Function CreateDoubleToDouble(V8Engine engine, JNIV8Function.DoubleToDoubleHandler handler);
+
+    public static native JNIV8Function CreateDoubleDoubleToVoid(V8Engine engine, JNIV8Function.DoubleDoubleToVoidHandler handler);
+
+    public static native JNIV8Function CreateIntToObject(V8Engine engine, JNIV8Function.IntToObjectHandler handler);
+
+    public static native JNIV8Function CreateStringToString(V8Engine engine, JNIV8Function.StringToStringHandler handler);
+
     public @Nullable
     Object callAsV8Function(@Nullable Object... arguments) {
         String callContext = "callAsV8Function";
@@ -57,6 +89,34 @@ public final class JNIV8Function extends JNIV8Object {
     }
 
 
+    /**
+     * Calls the function with numeric arguments and converts the result to a number (undefined becomes NaN).
+     * Arguments are transferred in a single JNI call without boxing; use these variants for small functions that
+     * are called with a high frequency
+     */
+    public double callAsV8FunctionDouble(@NonNull double... arguments) {
+        return _applyAsV8FunctionDouble("callAsV8FunctionDouble", arguments, 0, arguments.length, false);
+    }
+
+    public double applyAsV8FunctionDouble(@NonNull double[] arguments, int offset, int count) {
+        return _applyAsV8FunctionDouble("applyAsV8FunctionDouble", arguments, offset, count, false);
+    }
+
+    /**
+     * Calls the function with numeric arguments and ignores its result
+     */
+    public void callAsV8FunctionVoid(double argument1, double argument2) {
+        _callAsV8FunctionVoid("callAsV8FunctionVoid", argument1, argument2);
+    }
+
+    public void callAsV8FunctionVoid(@NonNull double... arguments) {
+        _applyAsV8FunctionDouble("callAsV8FunctionVoid", arguments, 0, arguments.length, true);
+    }
+
+    public void applyAsV8FunctionVoid(@NonNull double[] arguments, int offset, int count) {
+        _applyAsV8FunctionDouble("applyAsV8FunctionVoid", arguments, offset, count, true);
+    }
+
     @SuppressWarnings("unchecked")
     public @Nullable
     <T> T callAsV8FunctionTyped(int flags, @NonNull Class<T> returnType, @Nullable Object... arguments) {
@@ -113,6 +173,8 @@ public final class JNIV8Function extends JNIV8Object {
     //------------------------------------------------------------------------
     // internal fields & methods
     private native Object _callAsV8Function(boolean asConstructor, int flags, int type, Class returnType, Object receiver, String callContext, Object... arguments);
+    private native double _applyAsV8FunctionDouble(String callContext, double[] arguments, int offset, int count, boolean discardResult);
+    private native void _callAsV8FunctionVoid(String callContext, double argument1, double argument2);
 
     @Keep
     private JNIV8Function(V8Engine engine, long jsObjPtr, Object[] arguments) {
@@ -3,8 +3,8 @@ package ag.boersego.bgjs;
 import androidx.annotation.Keep;
 import androidx.annotation.NonNull;
 
+import java.util.List;
 import java.util.Map;
-import java.util.Set;
 
 /**
  * Created by martin on 26.09.17.
@@ -16,6 +16,25 @@ public final class JNIV8GenericObject extends JNIV8Object {
 
     public static native JNIV8GenericObject Create(V8Engine engine);
 
+    /**
+     * Create a JS object that is a live view of the given list.
+     * Elements are not copied; reads and writes from JS go directly to the list.
+     * The view has a length property and can be iterated like a JS array.
+     */
+    public static native JNIV8GenericObject CreateListView(V8Engine engine, @NonNull List<?> list);
+
+    /**
+     * Create a JS object that is a live view of the given map.
+     * Properties read, written or deleted from JS are looked up in and applied to the map.
+     */
+    public static native JNIV8GenericObject CreateMapView(V8Engine engine, @NonNull Map<String, ?> map);
+
+    /**
+     * Create a JS object that is a live view of the given array.
+     * Supported are Object[], double[], float[], int[] and long[]; the size of the array cannot be changed from JS.
+     */
+    public static native JNIV8GenericObject CreateArrayView(V8Engine engine, @NonNull Object array);
+
     @Override
     public void dispose() throws RuntimeException {
         super.dispose();
@@ -28,21 +47,8 @@ public final class JNIV8GenericObject extends JNIV8Object {
         super(engine, jsObjPtr, arguments);
     }
 
-    public static JNIV8GenericObject fromMap(final V8Engine engine, @NonNull final Map<String, Object> map) {
-        final JNIV8GenericObject instance = Create(engine);
-
-        final Set<Map.Entry<String, Object>> entrySet = map.entrySet();
-        for (Map.Entry<String, Object> entry : entrySet) {
-            final Object value = entry.getValue();
-            // We can recursively process maps into JNIV8GenericObjects
-            if (value instanceof Map) {
-                final JNIV8GenericObject innerInstance = JNIV8GenericObject.fromMap(engine, (Map<String, Object>)value);
-                instance.setV8Field(entry.getKey(), innerInstance);
-            } else {
-                instance.setV8Field(entry.getKey(), value);
-            }
-        }
-
-        return instance;
+    public static JNIV8GenericObject fromMap(final V8Engine engine, @NonNull final Map<String, ?> map) {
+        // the whole map (including nested maps and lists) is converted natively under a single lock
+        return (JNIV8GenericObject) engine.createV8Graph(map);
     }
 }
@@ -4,6 +4,8 @@ import androidx.annotation.NonNull;
 import androidx.annotation.Nullable;
 
 import java.lang.reflect.Modifier;
+import java.nio.ByteBuffer;
+import java.util.List;
 import java.util.Map;
 
 /**
@@ -39,6 +41,29 @@ public abstract class JNIV8Object extends JNIObject {
     public native double toNumber();
     public native String toString();
     public native String toJSON();
+
+    /**
+     * Convert this object and everything reachable from it to plain java objects in a single native call.
+     * Plain JS objects become HashMaps, arrays become ArrayLists, primitives are boxed;
+     * all other values (functions, class instances, ...) are returned as their usual wrappers.
+     */
+    public native Object toJavaGraph();
+
+    /**
+     * Serialize this object in V8's structured clone format into a new direct ByteBuffer.
+     * Typed arrays, dates, maps and sets are preserved; restore the value with {@link V8Engine#deserialize(ByteBuffer)}.
+     * Fails if the graph contains objects backed by java objects; use {@link #serialize(List)} for those.
+     */
+    public ByteBuffer serialize() {
+        return serialize(null);
+    }
+
+    /**
+     * Serialize this object in V8's structured clone format into a new direct ByteBuffer.
+     * Objects backed by java objects (JNIV8Object instances) are appended to hostObjects and only referenced by
+     * index in the buffer; pass the same list to {@link V8Engine#deserialize(ByteBuffer, List)}.
+     */
+    public native ByteBuffer serialize(@Nullable List<Object> hostObjects);
     public native boolean isInstanceOf(JNIV8Function constructor);
     public native boolean isInstanceOf(String name);
 
@@ -60,6 +85,20 @@ public abstract class JNIV8Object extends JNIObject {
 
     private native Object _applyV8Method(@NonNull String name, int flags, int type, Class returnType, Object[] arguments);
 
+    public @Nullable Object applyV8Method(@NonNull V8Key key, Object[] arguments) {
+        return _applyV8Method(key, 0, 0, Object.class, arguments);
+    }
+    @SuppressWarnings({"unchecked"})
+    public @Nullable <T> T applyV8MethodTyped(@NonNull V8Key key, int flags, @NonNull Class<T> returnType, @NonNull Object[] arguments) {
+        return (T) _applyV8Method(key, flags, returnType.hashCode(), returnType, arguments);
+    }
+    @SuppressWarnings({"unchecked"})
+    public @Nullable <T> T applyV8MethodTyped(@NonNull V8Key key, @NonNull Class<T> returnType, @NonNull Object[] arguments) {
+        return (T) _applyV8Method(key, V8Flags.Default, returnType.hashCode(), returnType, arguments);
+    }
+
+    private native Object _applyV8Method(@NonNull V8Key key, int flags, int type, Class returnType, Object[] arguments);
+
     public @Nullable Object callV8Method(@NonNull String name, Object... arguments) {
         return _applyV8Method(name, 0, 0, Object.class, arguments);
     }
@@ -72,6 +111,18 @@ public abstract class JNIV8Object extends JNIObject {
         return (T) _applyV8Method(name, V8Flags.Default, returnType.hashCode(), returnType, arguments);
     }
 
+    public @Nullable Object callV8Method(@NonNull V8Key key, Object... arguments) {
+        return _applyV8Method(key, 0, 0, Object.class, arguments);
+    }
+    @SuppressWarnings({"unchecked"})
+    public @Nullable <T> T callV8MethodTyped(@NonNull V8Key key,  int flags, @NonNull Class<T> returnType, @Nullable Object... arguments) {
+        return (T) _applyV8Method(key, flags, returnType.hashCode(), returnType, arguments);
+    }
+    @SuppressWarnings({"unchecked"})
+    public @Nullable <T> T callV8MethodTyped(@NonNull V8Key key, @NonNull Class<T> returnType, @Nullable Object... arguments) {
+        return (T) _applyV8Method(key, V8Flags.Default, returnType.hashCode(), returnType, arguments);
+    }
+
     public @Nullable Object getV8Field(@NonNull String name) {
         return _getV8Field(name, 0, 0, Object.class);
     }
@@ -85,12 +136,31 @@ public abstract class JNIV8Object extends JNIObject {
     }
     private native Object _getV8Field(String name, int flags, int type, Class returnType);
 
+    public @Nullable Object getV8Field(@NonNull V8Key key) {
+        return _getV8Field(key, 0, 0, Object.class);
+    }
+    @SuppressWarnings({"unchecked"})
+    public @Nullable <T> T getV8FieldTyped(@NonNull V8Key key, int flags, @NonNull Class<T> returnType) {
+        return (T) _getV8Field(key, flags, returnType.hashCode(), returnType);
+    }
+    @SuppressWarnings({"unchecked"})
+    public @Nullable <T> T getV8FieldTyped(@NonNull V8Key key, @NonNull Class<T> returnType) {
+        return (T) _getV8Field(key, V8Flags.Default, returnType.hashCode(), returnType);
+    }
+    private native Object _getV8Field(V8Key key, int flags, int type, Class returnType);
+
     public boolean hasV8Field(@NonNull String name) {
         return hasV8Field(name, false);
     }
     public boolean hasV8OwnField(@NonNull String name) {
         return hasV8Field(name, true);
     }
+    public boolean hasV8Field(@NonNull V8Key key) {
+        return hasV8Field(key, false);
+    }
+    public boolean hasV8OwnField(@NonNull V8Key key) {
+        return hasV8Field(key, true);
+    }
 
     public @NonNull String[] getV8Keys() {
         return getV8Keys(false);
@@ -124,9 +194,20 @@ public abstract class JNIV8Object extends JNIObject {
     }
 
     public native void setV8Field(@NonNull String name, @Nullable Object value);
+    public native void setV8Field(@NonNull V8Key key, @Nullable Object value);
     public native void setV8Fields(@NonNull Map< String, Object> fields);
     public native void setV8Accessor(@NonNull String name, @NonNull JNIV8Function getter, @Nullable JNIV8Function setter);
 
+    /**
+     * reads all fields described by the schema into target (in schema order) with a single call
+     */
+    public native void readFields(@NonNull V8FieldSchema schema, @NonNull double[] target);
+
+    /**
+     * writes all fields described by the schema from source (in schema order) with a single call
+     */
+    public native void writeFields(@NonNull V8FieldSchema schema, @NonNull double[] source);
+
     /**
      * convert a wrapped object to a number using the javascript coercion rules
      * @param obj
@@ -216,6 +297,26 @@ public abstract class JNIV8Object extends JNIObject {
 
     protected native void adjustJSExternalMemory(long change);
 
+    /**
+     * wrapper objects (e.g. JNIV8GenericObject, JNIV8Function, JNIV8Array) are shared: while a wrapper is reachable,
+     * the same instance is returned every time its js value is passed to java.
+     * Code that keeps a wrapper it received and disposes it later has to take a share with this method first; every
+     * call must be paired with exactly one call to dispose().
+     */
+    public void retain() {
+        retainWrapperShare();
+    }
+
+    /**
+     * releases a share taken with retain(); the jni side is only disposed once all shares have been released.
+     * Without outstanding shares, the object is disposed right away.
+     */
+    @Override
+    protected void dispose() throws RuntimeException {
+        if(!isDisposed() && !releaseWrapperShare()) return;
+        super.dispose();
+    }
+
     //------------------------------------------------------------------------
     // internal fields & methods
     private final V8Engine engine;
@@ -235,7 +336,10 @@ public abstract class JNIV8Object extends JNIObject {
     }
 
     private native boolean hasV8Field(String name, boolean ownOnly);
+    private native boolean hasV8Field(V8Key key, boolean ownOnly);
     private native String[] getV8Keys(boolean ownOnly);
     private native Map<String,Object> getV8Fields(boolean ownOnly, int flags, int type, Class returnType);
     private native void initNativeJNIV8Object(String canonicalName, V8Engine engine, long jsObjPtr);
+    private native void retainWrapperShare();
+    private native boolean releaseWrapperShare();
 }
@@ -4,10 +4,15 @@ import androidx.annotation.Keep;
 import androidx.annotation.NonNull;
 import androidx.annotation.Nullable;
 
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CompletionException;
+import java.util.concurrent.CompletionStage;
+import java.util.function.BiConsumer;
+
 import ag.boersego.v8annotations.V8Flags;
 
 public class JNIV8Promise extends JNIV8Object {
-    public static class Resolver extends JNIV8Object {
+    public static class Resolver extends JNIV8Object implements BiConsumer<Object, Throwable> {
         //------------------------------------------------------------------------
         // internal fields & methods
         @Keep
@@ -18,10 +23,49 @@ public class JNIV8Promise extends JNIV8Object {
         public native @NonNull JNIV8Promise getPromise();
         public native boolean resolve(@Nullable Object value);
         public native boolean reject(@Nullable Object value);
+
+        /**
+         * Resolves the promise without locking the engine on the calling thread.
+         * The promise is resolved on the engine thread, in a batch with all other promises settled asynchronously.
+         */
+        public native void resolveAsync(@Nullable Object value);
+
+        /**
+         * Rejects the promise without locking the engine on the calling thread; see {@link #resolveAsync(Object)}.
+         * Throwables are converted to JS errors, like exceptions thrown by Java code called from JS.
+         */
+        public native void rejectAsync(@Nullable Object value);
+
+        /**
+         * Settles the promise asynchronously with the result of a completion stage.
+         */
+        @Override
+        public void accept(@Nullable Object value, @Nullable Throwable error) {
+            if (error == null) {
+                resolveAsync(value);
+                return;
+            }
+            if (error instanceof CompletionException && error.getCause() != null) {
+                error = error.getCause();
+            }
+            rejectAsync(error);
+        }
     }
 
     public static native Resolver CreateResolver(@NonNull V8Engine engine);
 
+    /**
+     * Creates a promise that is settled with the result of the specified stage.
+     * The stage can be completed on any thread; the promise is settled asynchronously on the engine thread.
+     */
+    public static native @NonNull JNIV8Promise FromFuture(@NonNull V8Engine engine, @NonNull CompletionStage<?> future);
+
+    /**
+     * Returns a future that is completed with the result of this promise.
+     * The future is completed on the engine thread; rejections complete it exceptionally with a V8Exception.
+     */
+    public native @NonNull CompletableFuture<Object> toFuture();
+
     public @NonNull JNIV8Promise then(@NonNull JNIV8Function resolvedHandler) {
         JNIV8Promise promise = callV8MethodTyped("then", V8Flags.NonNull, JNIV8Promise.class, resolvedHandler);
         if(promise == null) throw new NullPointerException();
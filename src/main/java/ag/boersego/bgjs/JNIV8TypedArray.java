@@ -14,4 +14,52 @@ public final class JNIV8TypedArray extends JNIV8Object {
      * returns the length of the array
      */
     public native int getV8Length();
+
+    /**
+     * copies `length` elements starting at `offset` into the specified array
+     * elements are converted if the TypedArray is not a Float32Array
+     */
+    public native void readRegion(int offset, int length, float[] target);
+
+    /**
+     * copies `length` elements starting at `offset` into the specified array
+     * elements are converted if the TypedArray is not a Float64Array
+     */
+    public native void readRegion(int offset, int length, double[] target);
+
+    /**
+     * copies `length` elements starting at `offset` into the specified array
+     * elements are converted if the TypedArray is not an Int32Array or Uint32Array
+     */
+    public native void readRegion(int offset, int length, int[] target);
+
+    /**
+     * copies `length` elements starting at `offset` into the specified array
+     * elements are converted if the TypedArray is not an Int8Array, Uint8Array or Uint8ClampedArray
+     */
+    public native void readRegion(int offset, int length, byte[] target);
+
+    /**
+     * copies the first `length` elements of the specified array into the TypedArray starting at `offset`
+     * elements are converted if the TypedArray is not a Float32Array
+     */
+    public native void writeRegion(int offset, int length, float[] source);
+
+    /**
+     * copies the first `length` elements of the specified array into the TypedArray starting at `offset`
+     * elements are converted if the TypedArray is not a Float64Array
+     */
+    public native void writeRegion(int offset, int length, double[] source);
+
+    /**
+     * copies the first `length` elements of the specified array into the TypedArray starting at `offset`
+     * elements are converted if the TypedArray is not an Int32Array or Uint32Array
+     */
+    public native void writeRegion(int offset, int length, int[] source);
+
+    /**
+     * copies the first `length` elements of the specified array into the TypedArray starting at `offset`
+     * elements are converted if the TypedArray is not an Int8Array or Uint8Array
+     */
+    public native void writeRegion(int offset, int length, byte[] source);
 }
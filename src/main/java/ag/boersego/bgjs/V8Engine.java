@@ -8,9 +8,13 @@ import android.os.Looper;
 import android.util.Log;
 
 import androidx.annotation.NonNull;
+import androidx.annotation.Nullable;
 
 import java.io.File;
+import java.nio.ByteBuffer;
 import java.util.ArrayList;
+import java.util.List;
+import java.util.function.Supplier;
 
 /**
  * v8Engine
@@ -39,6 +43,9 @@ public class V8Engine extends JNIObject {
 
     private final ArrayList<JNIV8Module> mModules = new ArrayList<>();
 
+    private boolean mPooledArrayBuffers = false;
+    private long mMaxCachedArrayBufferBytes = 8 * 1024 * 1024;
+
     public native void pause();
 
     public native void unpause();
@@ -72,6 +79,48 @@ public class V8Engine extends JNIObject {
         runLocked(ownerName, runInLocker);
     }
 
+    /**
+     * Execute a Runnable inside of a v8 session on this engine.
+     * <p>
+     * The lock and all v8 scopes are entered only once for the whole block; all V8 calls made from inside
+     * of the block reuse them instead of entering them again. Microtasks (e.g. promise reactions) are run
+     * once when the block is left.
+     * Sessions can be nested; only the outermost session actually enters the engine.
+     *
+     * @param ownerName a descriptive lock-owner name for lock monitoring in C++
+     * @param block the Runnable to execute inside of the session
+     */
+    public void withLock(String ownerName, final Runnable block) {
+        final long session = openSession(ownerName);
+        try {
+            block.run();
+        } finally {
+            closeSession(session);
+        }
+    }
+
+    public void withLock(final Runnable block) {
+        withLock("JAVA-Session", block);
+    }
+
+    /**
+     * Execute a Supplier inside of a v8 session on this engine and return its result
+     *
+     * @see #withLock(String, Runnable)
+     */
+    public <T> T withLockResult(String ownerName, final Supplier<T> block) {
+        final long session = openSession(ownerName);
+        try {
+            return block.get();
+        } finally {
+            closeSession(session);
+        }
+    }
+
+    public <T> T withLockResult(final Supplier<T> block) {
+        return withLockResult("JAVA-Session", block);
+    }
+
     /**
      * Enqueue a callback to be executed in v8 loop thread on next tick
      *
@@ -83,6 +132,21 @@ public class V8Engine extends JNIObject {
         void onReady();
     }
 
+    /**
+     * Use a pooled allocator for array buffers: freed buffers of up to 64 KB are kept in free lists and reused.
+     * Must be called before the engine is started.
+     *
+     * @param enabled whether to use the pooled allocator
+     * @param maxCachedBytes upper limit for the memory kept in free lists
+     */
+    public void setPooledArrayBuffers(boolean enabled, long maxCachedBytes) {
+        if (mStoragePath != null) {
+            throw new IllegalStateException("V8Engine was already started");
+        }
+        mPooledArrayBuffers = enabled;
+        mMaxCachedArrayBufferBytes = maxCachedBytes;
+    }
+
     public void start(final @NonNull Context application) {
         _initialize(application, "node_modules/");
     }
@@ -102,7 +166,7 @@ public class V8Engine extends JNIObject {
         // this will create an eventloop thread on the native side
         // intitialization of the v8 context & the `onReady` callback will run inside of that thread
         final int maxHeapSizeForV8 = (int) (Runtime.getRuntime().maxMemory() / 1024 / 1024 / 3);
-        initialize(application.getAssets(), commonJSPath, maxHeapSizeForV8);
+        initialize(application.getAssets(), commonJSPath, maxHeapSizeForV8, mPooledArrayBuffers, mMaxCachedArrayBufferBytes);
     }
 
     public boolean isReady() {
@@ -124,6 +188,37 @@ public class V8Engine extends JNIObject {
 
     public native Object parseJSON(String json);
 
+    /**
+     * Convert a graph of java objects to JS in a single native call.
+     * Maps become plain objects, Lists, Collections and Object[] become arrays; all other values are converted as usual.
+     * Returns the wrapper of the root object, e.g. a JNIV8GenericObject for a Map or a JNIV8Array for a List.
+     */
+    public native Object createV8Graph(Object graph);
+
+    /**
+     * Restore a value serialized with {@link JNIV8Object#serialize()}.
+     * The bytes between the buffer's position and limit are read; heap buffers are copied to a direct buffer first.
+     */
+    public Object deserialize(@NonNull ByteBuffer buffer) {
+        return deserialize(buffer, null);
+    }
+
+    /**
+     * Restore a value serialized with {@link JNIV8Object#serialize(List)}, resolving references to java backed
+     * objects from hostObjects.
+     */
+    public Object deserialize(@NonNull ByteBuffer buffer, @Nullable List<?> hostObjects) {
+        if (!buffer.isDirect()) {
+            final ByteBuffer direct = ByteBuffer.allocateDirect(buffer.remaining());
+            direct.put(buffer.duplicate());
+            direct.flip();
+            buffer = direct;
+        }
+        return _deserialize(buffer, buffer.position(), buffer.remaining(), hostObjects != null ? hostObjects.toArray() : null);
+    }
+
+    private native Object _deserialize(ByteBuffer buffer, int offset, int length, Object[] hostObjects);
+
     public native Object runScript(String script, String name);
 
     public native Object require(String file);
@@ -146,6 +241,74 @@ public class V8Engine extends JNIObject {
      */
     public native void logHeapStats();
 
+    /**
+     * Console messages of this engine below the specified priority (see {@link Log}) are discarded before their
+     * arguments are converted. Defaults to {@link Log#DEBUG}.
+     */
+    public native void setMinLogLevel(int priority);
+
+    /**
+     * Additionally appends the console output of all engines to the specified file, or stops doing so if null.
+     * Messages are written on a background thread.
+     */
+    public static native void setLogFile(@Nullable String path);
+
+    /**
+     * Returns the number of bound classes whose templates were built in this engine.
+     * Templates are built lazily, when a class is first wrapped, constructed or exposed to JS.
+     */
+    public native int getNumClassTemplates();
+
+    /**
+     * Categories of native memory that is retained by JS objects and reported to V8 as external memory.
+     */
+    public enum ExternalMemoryType {
+        HEAP,
+        GPU
+    }
+
+    /**
+     * Returns the number of bytes of native memory of the specified category that is currently retained by JS objects.
+     */
+    public long getExternalMemory(ExternalMemoryType type) {
+        return _getExternalMemory(type.ordinal());
+    }
+
+    private native long _getExternalMemory(int type);
+
+    /**
+     * Sets the stack trace of a V8JSException caused by JS. See V8JSException.materialize.
+     * Unless wait is true, this returns false instead of waiting if the current thread does not hold the engine lock.
+     */
+    native boolean materializeStackTrace(V8JSException exception, Object v8Exception, String fileName, int lineNumber, boolean wait);
+
+    /**
+     * Returns the number of bytes held by live array buffers, or -1 if the pooled allocator is not used.
+     */
+    public native long getArrayBufferLiveBytes();
+
+    /**
+     * Returns the number of bytes of freed array buffers kept for reuse, or -1 if the pooled allocator is not used.
+     */
+    public native long getArrayBufferCachedBytes();
+
+    /**
+     * Enables or disables recording of isolate lock wait and hold times for all engines; disabled by default.
+     * Enabling it is cheap enough to leave it on in production.
+     * @see #getLockProfile()
+     */
+    public static native void setLockProfilingEnabled(boolean enabled);
+
+    /**
+     * Returns the recorded isolate lock statistics of all engines, one entry per lock owner
+     */
+    public static native @NonNull V8LockProfile[] getLockProfile();
+
+    /**
+     * Clears all recorded isolate lock statistics
+     */
+    public static native void resetLockProfile();
+
     public native JNIV8GenericObject getGlobalObject();
 
     /**
@@ -164,6 +327,22 @@ public class V8Engine extends JNIObject {
      */
     private native void unlock(long lockerPtr);
 
+    /**
+     * Enter the engine (lock + all v8 scopes) and return the pointer to the native session
+     *
+     * @param ownerName a descriptive lock-owner name for lock monitoring in C++
+     *
+     * @return pointer to the native session
+     */
+    private native long openSession(String ownerName);
+
+    /**
+     * Leave a session that was opened with openSession; runs pending microtasks if it was the outermost session
+     *
+     * @param sessionPtr the pointer to the session instance
+     */
+    private native void closeSession(long sessionPtr);
+
     public synchronized void addStatusHandler(final V8EngineHandler h) {
         if (mReady) {
             h.onReady();
@@ -234,5 +413,6 @@ public class V8Engine extends JNIObject {
 
     public native void shutdown();
 
-    private native void initialize(AssetManager am, String commonJSPath, final int maxHeapSizeInMb);
+    private native void initialize(AssetManager am, String commonJSPath, final int maxHeapSizeInMb,
+                                   boolean pooledArrayBuffers, long maxCachedArrayBufferBytes);
 }
@@ -23,15 +23,30 @@ public class V8Exception extends RuntimeException {
      * Could also be any other wrapped JS value (primitive, function, Java/V8 tuple) or null
      */
     public Object getV8Exception() {
-        Throwable cause = this.getCause();
+        Throwable cause = super.getCause();
         if(cause instanceof V8JSException) {
-            return ((V8Exception)cause).getV8Exception();
+            return ((V8JSException)cause).getV8Exception();
         }
         return null;
     }
 
+    /**
+     * the stack trace of the JavaScript exception is only created when it is first requested (see V8JSException)
+     * Throwable prints causes without calling their public methods, but it always retrieves them via getCause(), also
+     * when this exception is itself the cause of another exception; so the cause is materialized here
+     */
+    @Override
+    public Throwable getCause() {
+        Throwable cause = super.getCause();
+        if(cause instanceof V8JSException) {
+            ((V8JSException)cause).materialize();
+        }
+        return cause;
+    }
+
     //------------------------------------------------------------------------
     // internal fields & methods
+
     private V8Exception(String message, Throwable cause) {
         super(message, cause);
     }
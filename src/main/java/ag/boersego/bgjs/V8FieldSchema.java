@@ -0,0 +1,100 @@
+package ag.boersego.bgjs;
+
+import androidx.annotation.NonNull;
+
+/**
+ * Precompiled list of property names and primitive types
+ *
+ * A schema is created once per engine and can then be used to transfer all described fields of a js object
+ * from and to a double[] with a single call (see JNIV8Object.readFields/writeFields and
+ * JNIV8Array.readElementFields/writeElementFields).
+ *
+ * A schema can also create records: js objects that contain exactly the fields of the schema in schema order.
+ * All records of a schema share the same shape, so js code consuming them stays monomorphic.
+ */
+@SuppressWarnings("unused")
+public final class V8FieldSchema extends JNIObject {
+    /**
+     * type a field is converted to when reading, and stored as when writing
+     * values are always transferred as double on the java side
+     */
+    public enum Type {
+        DOUBLE(8),
+        INTEGER(5),
+        BOOLEAN(1);
+
+        // matches JNIV8JavaValueType on the native side
+        private final int nativeType;
+
+        Type(int nativeType) {
+            this.nativeType = nativeType;
+        }
+    }
+
+    private final V8Engine engine;
+    private final String[] keys;
+
+    /**
+     * creates a schema where all fields are of type DOUBLE
+     */
+    public V8FieldSchema(@NonNull V8Engine engine, @NonNull String... keys) {
+        this(engine, keys, null);
+    }
+
+    public V8FieldSchema(@NonNull V8Engine engine, @NonNull String[] keys, Type[] types) {
+        super();
+        if (types != null && types.length != keys.length) {
+            throw new IllegalArgumentException("keys and types must have the same length");
+        }
+        this.engine = engine;
+        this.keys = keys.clone();
+        final int[] nativeTypes = new int[keys.length];
+        for (int i = 0; i < keys.length; i++) {
+            nativeTypes[i] = (types != null ? types[i] : Type.DOUBLE).nativeType;
+        }
+        initNativeV8FieldSchema(engine, this.keys, nativeTypes);
+    }
+
+    public V8Engine getV8Engine() {
+        return engine;
+    }
+
+    /**
+     * returns the number of fields, i.e. the number of doubles transferred per object
+     */
+    public int getFieldCount() {
+        return keys.length;
+    }
+
+    /**
+     * returns the position of the field with the specified name, or -1
+     */
+    public int indexOf(@NonNull String key) {
+        for (int i = 0; i < keys.length; i++) {
+            if (keys[i].equals(key)) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * creates a record from one value per field, converted to the type of the field
+     */
+    public native JNIV8GenericObject createRecord(@NonNull double[] values);
+
+    /**
+     * creates a record from one value per field
+     * values are converted like any other java value; field types are not applied
+     */
+    public native JNIV8GenericObject createRecord(@NonNull Object[] values);
+
+    /**
+     * creates an array of records from getFieldCount() values per record, stored record after record
+     */
+    public native JNIV8Array createRecords(@NonNull double[] values);
+
+    //------------------------------------------------------------------------
+    // internal fields & methods
+    private native void initNativeV8FieldSchema(V8Engine engine, String[] keys, int[] types);
+}
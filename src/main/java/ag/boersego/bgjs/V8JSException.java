@@ -1,5 +1,11 @@
 package ag.boersego.bgjs;
 
+import java.io.PrintStream;
+import java.io.PrintWriter;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicBoolean;
+
 /**
  * This Exception represents a JavaScript exception (available via getV8Exception)
  *
@@ -25,6 +31,10 @@ package ag.boersego.bgjs;
  * This is done by: new V8JSException(engine, "RangeError", "The parameter was out of bounds")
  * This will construct a new instance of RangeError, and throw that in JavaScript.
  *
+ * For exceptions caused by JavaScript, the stack trace is only created when it is first requested, because many
+ * exceptions are caught and handled without ever being inspected. Until then, it only contains the location reported
+ * by JavaScript.
+ *
  * Created by martin on 23.10.17.
  */
 
@@ -66,13 +76,90 @@ public class V8JSException extends RuntimeException {
         return causedByJS;
     }
 
+    @Override
+    public StackTraceElement[] getStackTrace() {
+        materialize();
+        return super.getStackTrace();
+    }
+
+    @Override
+    public void printStackTrace(PrintStream s) {
+        materialize();
+        super.printStackTrace(s);
+    }
+
+    @Override
+    public void printStackTrace(PrintWriter s) {
+        materialize();
+        super.printStackTrace(s);
+    }
+
     //------------------------------------------------------------------------
     // internal fields & methods
+    private static final long MATERIALIZE_TIMEOUT_MS = 100;
+
     private final Object v8Exception;
     private final boolean causedByJS;
-    private V8JSException(String message, Object v8Exception, Throwable cause) {
+    // location reported by v8; used for syntax errors and if no stack trace is available
+    private final String fileName;
+    private final int lineNumber;
+    // only set until the stack trace was materialized
+    private volatile V8Engine engine;
+    // set while a task creating the stack trace is queued on the JavaScript thread
+    private final AtomicBoolean materializationPending = new AtomicBoolean();
+
+    private V8JSException(V8Engine engine, String message, Object v8Exception, Throwable cause, String fileName, int lineNumber) {
         super(message, cause);
         this.v8Exception = v8Exception;
         this.causedByJS = true;
+        this.engine = engine;
+        this.fileName = fileName;
+        this.lineNumber = lineNumber;
+        setStackTrace(new StackTraceElement[]{
+                new StackTraceElement("<unknown>", "<unknown>", fileName, fileName != null ? (lineNumber >= 1 ? lineNumber : -1) : -2)
+        });
+    }
+
+    /**
+     * creates the stack trace from the JavaScript exception
+     * This requires the engine lock. Exceptions are logged from arbitrary threads, which might hold monitors the
+     * JavaScript thread is waiting for, so this never blocks on the lock: if the current thread does not hold it
+     * already, the stack trace is created on the JavaScript thread, and only waited for a short time. If that does not
+     * happen in time, the exception keeps its location for now and this is tried again on the next request.
+     * Only one task is queued at a time; requests made while it is pending return immediately.
+     */
+    void materialize() {
+        final V8Engine engine = this.engine;
+        if (engine == null) {
+            return;
+        }
+
+        if (!engine.materializeStackTrace(this, v8Exception, fileName, lineNumber, false)) {
+            if (!materializationPending.compareAndSet(false, true)) {
+                return;
+            }
+            final CountDownLatch latch = new CountDownLatch(1);
+            try {
+                engine.enqueueOnNextTick(() -> {
+                    if (this.engine != null && engine.materializeStackTrace(this, v8Exception, fileName, lineNumber, true)) {
+                        this.engine = null;
+                    }
+                    materializationPending.set(false);
+                    latch.countDown();
+                });
+            } catch (RuntimeException e) {
+                // engine is not running anymore
+                this.engine = null;
+                materializationPending.set(false);
+                return;
+            }
+            try {
+                latch.await(MATERIALIZE_TIMEOUT_MS, TimeUnit.MILLISECONDS);
+            } catch (InterruptedException e) {
+                Thread.currentThread().interrupt();
+            }
+            return;
+        }
+        this.engine = null;
     }
 }
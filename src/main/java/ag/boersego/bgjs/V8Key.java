@@ -0,0 +1,40 @@
+package ag.boersego.bgjs;
+
+import androidx.annotation.NonNull;
+
+/**
+ * Reusable handle for a property name of a js object
+ *
+ * The name is converted and internalized only once when the key is created, so using it
+ * with the field and method accessors of JNIV8Object skips all string conversion.
+ * Keys are bound to the engine they were created for.
+ */
+@SuppressWarnings("unused")
+public final class V8Key extends JNIObject {
+    private final V8Engine engine;
+    private final String name;
+
+    public V8Key(@NonNull V8Engine engine, @NonNull String name) {
+        super();
+        this.engine = engine;
+        this.name = name;
+        initNativeV8Key(engine, name);
+    }
+
+    public V8Engine getV8Engine() {
+        return engine;
+    }
+
+    public @NonNull String getName() {
+        return name;
+    }
+
+    @Override
+    public @NonNull String toString() {
+        return name;
+    }
+
+    //------------------------------------------------------------------------
+    // internal fields & methods
+    private native void initNativeV8Key(V8Engine engine, String name);
+}
@@ -0,0 +1,81 @@
+package ag.boersego.bgjs;
+
+import androidx.annotation.NonNull;
+
+import java.util.Locale;
+
+/**
+ * Isolate lock statistics of a single lock owner, as returned by {@link V8Engine#getLockProfile()}
+ *
+ * The owner is the name of the native function that took the lock. Wait and hold times are in nanoseconds and only
+ * include outermost locks; recursive locks are counted but never wait. Bucket 0 of the histograms counts durations
+ * below 1µs, bucket i &gt; 0 durations of [2^(i-1), 2^i) µs, and the last bucket everything above.
+ */
+@SuppressWarnings("unused")
+public final class V8LockProfile {
+    private final String ownerName;
+    private final long numAcquires;
+    private final long numRecursiveAcquires;
+    private final long totalWaitTime;
+    private final long maxWaitTime;
+    private final long totalHoldTime;
+    private final long maxHoldTime;
+    private final long[] waitHistogram;
+    private final long[] holdHistogram;
+
+    V8LockProfile(String ownerName, long numAcquires, long numRecursiveAcquires, long totalWaitTime, long maxWaitTime,
+                  long totalHoldTime, long maxHoldTime, long[] waitHistogram, long[] holdHistogram) {
+        this.ownerName = ownerName;
+        this.numAcquires = numAcquires;
+        this.numRecursiveAcquires = numRecursiveAcquires;
+        this.totalWaitTime = totalWaitTime;
+        this.maxWaitTime = maxWaitTime;
+        this.totalHoldTime = totalHoldTime;
+        this.maxHoldTime = maxHoldTime;
+        this.waitHistogram = waitHistogram;
+        this.holdHistogram = holdHistogram;
+    }
+
+    public @NonNull String getOwnerName() {
+        return ownerName;
+    }
+
+    public long getNumAcquires() {
+        return numAcquires;
+    }
+
+    public long getNumRecursiveAcquires() {
+        return numRecursiveAcquires;
+    }
+
+    public long getTotalWaitTime() {
+        return totalWaitTime;
+    }
+
+    public long getMaxWaitTime() {
+        return maxWaitTime;
+    }
+
+    public long getTotalHoldTime() {
+        return totalHoldTime;
+    }
+
+    public long getMaxHoldTime() {
+        return maxHoldTime;
+    }
+
+    public @NonNull long[] getWaitHistogram() {
+        return waitHistogram;
+    }
+
+    public @NonNull long[] getHoldHistogram() {
+        return holdHistogram;
+    }
+
+    @Override
+    public @NonNull String toString() {
+        return String.format(Locale.US, "%s: %d locks (%d recursive), wait %.3fms (max %.3fms), hold %.3fms (max %.3fms)",
+                ownerName, numAcquires, numRecursiveAcquires, totalWaitTime / 1e6, maxWaitTime / 1e6,
+                totalHoldTime / 1e6, maxHoldTime / 1e6);
+    }
+}
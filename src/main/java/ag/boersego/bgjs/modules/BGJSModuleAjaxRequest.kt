@@ -47,6 +47,8 @@ class BGJSModuleAjaxRequest(engine: V8Engine) : JNIV8Object(engine), Runnable {
     @V8Function
     fun done(cb: JNIV8Function?): BGJSModuleAjaxRequest {
         if (cb != null && requestNotFinal) {
+            // the function is disposed on abort; it might also be held by other callers
+            cb.retain()
             callbacks.add(Pair(CallbackType.DONE, cb))
         }
         return this
@@ -55,6 +57,8 @@ class BGJSModuleAjaxRequest(engine: V8Engine) : JNIV8Object(engine), Runnable {
     @V8Function
     fun fail(cb: JNIV8Function?): BGJSModuleAjaxRequest {
         if (cb != null && requestNotFinal) {
+            // the function is disposed on abort; it might also be held by other callers
+            cb.retain()
             callbacks.add(Pair(CallbackType.FAIL, cb))
         }
         return this
@@ -63,6 +67,8 @@ class BGJSModuleAjaxRequest(engine: V8Engine) : JNIV8Object(engine), Runnable {
     @V8Function
     fun always(cb: JNIV8Function?): BGJSModuleAjaxRequest {
         if (cb != null && requestNotFinal) {
+            // the function is disposed on abort; it might also be held by other callers
+            cb.retain()
             callbacks.add(Pair(CallbackType.ALWAYS, cb))
         }
         return this
@@ -218,6 +224,8 @@ class BGJSModuleAjaxRequest(engine: V8Engine) : JNIV8Object(engine), Runnable {
                 }
             }
         }
+        // release the shares taken when the callbacks were added
+        callbacks.forEach { it.second.dispose() }
         callbacks.clear()
     }
 
@@ -14,10 +14,10 @@ import javax.annotation.processing.SupportedSourceVersion;
 import javax.lang.model.SourceVersion;
 import javax.lang.model.element.AnnotationMirror;
 import javax.lang.model.element.Element;
+import javax.lang.model.element.ElementKind;
 import javax.lang.model.element.ExecutableElement;
 import javax.lang.model.element.Modifier;
 import javax.lang.model.element.TypeElement;
-import javax.lang.model.element.VariableElement;
 import javax.lang.model.type.ArrayType;
 import javax.lang.model.type.ExecutableType;
 import javax.lang.model.type.TypeKind;
@@ -35,6 +35,7 @@ import ag.boersego.v8annotations.*;
                 "ag.boersego.v8annotations.V8Function",
                 "ag.boersego.v8annotations.V8Getter",
                 "ag.boersego.v8annotations.V8Setter",
+                "ag.boersego.v8annotations.V8Field",
                 "ag.boersego.v8annotations.V8UndefinedIsNull"
         }
 )
@@ -67,6 +68,7 @@ public final class V8AnnotationProcessor extends AbstractProcessor {
         String property;
         Element getter;
         Element setter;
+        Element field;
         TypeMirror kind;
     }
 
@@ -234,6 +236,28 @@ public final class V8AnnotationProcessor extends AbstractProcessor {
 
         index = 0;
         for (AccessorTuple tuple : holder.annotatedAccessors) {
+            if (tuple.field != null) {
+                // field bindings are accessed directly from native code; no getter or setter is involved
+                String typeCode = tuple.kind != null ? getJniCodeForType(tuple.field, tuple.kind, false) : null;
+                boolean isReadOnly = tuple.field.getModifiers().contains(Modifier.FINAL) || tuple.field.getAnnotation(V8Field.class).readOnly();
+                builder.append("\t\t\t")
+                        .append(index++ == 0 ? "" : ",")
+                        .append("new V8AccessorInfo(\"")
+                        .append(tuple.property)
+                        .append("\", ");
+                if (typeCode != null) {
+                    builder.append("\"").append(typeCode).append("\", ");
+                } else {
+                    builder.append("null, ");
+                }
+                builder.append("\"").append(tuple.field.getSimpleName().toString()).append("\", ")
+                        .append(isReadOnly ? "true, " : "false, ")
+                        .append(tuple.field.getModifiers().contains(Modifier.STATIC) ? "true, " : "false, ")
+                        .append(tuple.nullable ? "true, " : "false, ")
+                        .append(tuple.undefinedIsNull ? "true" : "false")
+                        .append(")\n");
+                continue;
+            }
             String getterName = tuple.getter != null ? tuple.getter.getSimpleName().toString() : null;
             String setterName = tuple.setter != null ? tuple.setter.getSimpleName().toString() : null;
             String typeCode = null;
@@ -427,6 +451,32 @@ public final class V8AnnotationProcessor extends AbstractProcessor {
             }
             tuple.setter = element;
         }
+        for (Element element : env.getElementsAnnotatedWith(V8Field.class)) {
+            // determine property name
+            String property;
+            V8Symbols symbol = element.getAnnotation(V8Field.class).symbol();
+            if(symbol != V8Symbols.NONE) {
+                property = symbolIdentifier + symbol.toString();
+            } else {
+                property = element.getAnnotation(V8Field.class).property();
+                if (property.isEmpty()) {
+                    property = element.getSimpleName().toString();
+                }
+                property = "string:" + property;
+            }
+            AccessorTuple tuple = getAccessorTuple(annotatedClasses, element, property);
+            if (tuple.getter != null || tuple.setter != null || tuple.field != null) {
+                processingEnv.getMessager().printMessage(Diagnostic.Kind.ERROR, "property is already bound to another field or accessor", element);
+            }
+
+            // store
+            TypeMirror fieldKind = element.asType();
+            if (validateAccessorType(element, fieldKind)) {
+                parseAccessorNullable(tuple, element, fieldKind);
+                tuple.kind = fieldKind;
+            }
+            tuple.field = element;
+        }
         for (String key : annotatedClasses.keySet()) {
             AnnotationHolder holder = annotatedClasses.get(key);
             generateBinding(holder);
@@ -442,7 +492,8 @@ public final class V8AnnotationProcessor extends AbstractProcessor {
         }
 
         boolean undefinedIsNull = false;
-        VariableElement param = ((ExecutableElement) element).getParameters().get(0);
+        // setters are annotated on their parameter, fields directly
+        Element param = element.getKind() == ElementKind.FIELD ? element : ((ExecutableElement) element).getParameters().get(0);
         List<? extends AnnotationMirror> mirrors = param.getAnnotationMirrors();
         for (AnnotationMirror annotation : mirrors) {
             final String annotationName = annotation.toString();
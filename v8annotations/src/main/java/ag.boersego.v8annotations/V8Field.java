@@ -0,0 +1,20 @@
+package ag.boersego.v8annotations;
+
+import java.lang.annotation.ElementType;
+import java.lang.annotation.Retention;
+import java.lang.annotation.RetentionPolicy;
+import java.lang.annotation.Target;
+
+/**
+ * Binds a JS property directly to a java field.
+ * Reads and writes access the field from native code without calling a getter or setter method.
+ * Final fields are exposed as read-only properties.
+ */
+
+@Retention(RetentionPolicy.SOURCE)
+@Target(ElementType.FIELD)
+public @interface V8Field {
+    String property() default "";
+    V8Symbols symbol() default V8Symbols.NONE;
+    boolean readOnly() default false;
+}
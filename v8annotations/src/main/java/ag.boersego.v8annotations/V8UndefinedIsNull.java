@@ -10,6 +10,6 @@ import java.lang.annotation.Target;
  */
 
 @Retention(RetentionPolicy.SOURCE)
-@Target({ElementType.METHOD, ElementType.PARAMETER})
+@Target({ElementType.METHOD, ElementType.PARAMETER, ElementType.FIELD})
 public @interface V8UndefinedIsNull {
 }
@@ -8,10 +8,12 @@ public class V8AccessorInfo {
     public String property;
     public String setter;
     public String getter;
+    public String field;
     public String type;
     public boolean isStatic;
     public boolean isNullable;
     public boolean undefinedIsNull;
+    public boolean isReadOnly;
 
     public V8AccessorInfo(String property, String type, String getter, String setter, boolean isStatic, boolean isNullable, boolean undefinedIsNull) {
         this.property = property;
@@ -22,4 +24,14 @@ public class V8AccessorInfo {
         this.isNullable = isNullable;
         this.undefinedIsNull = undefinedIsNull;
     }
+
+    public V8AccessorInfo(String property, String type, String field, boolean isReadOnly, boolean isStatic, boolean isNullable, boolean undefinedIsNull) {
+        this.property = property;
+        this.field = field;
+        this.type = type;
+        this.isReadOnly = isReadOnly;
+        this.isStatic = isStatic;
+        this.isNullable = isNullable;
+        this.undefinedIsNull = undefinedIsNull;
+    }
 }